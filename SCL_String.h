@@ -36,7 +36,7 @@ and expand and contract dynamically according to whatever the user throws at the
  - Additional functionality and clarity around file reading and conversion between strings and other base types,
 and additional structs to make working with strings and their conversions that much simpler.
 
-- There are only two allocation (calloc) and deallocation (free) points in the entire library.
+- There are only two allocation (Mem_Alloc) and deallocation (Mem_Free) points in the entire library.
 These can therefore be modified more easily to the user's own allocation methods, if desired.
 
 - This code runs without error messages when compiling via msvc with /Wall expect for those within <stdio.h>,
@@ -46,7 +46,7 @@ and error 4201 (nameless struct) & error 4820 (struct padding) which I accept as
 
 // NOTE(s0lly): Careful on ftell with large files due to return type
 // NOTE(s0lly): Using uint8_t as char representation - this may break code on certain platforms
-// NOTE(s0lly): Library assumes ASCII style strings only
+// NOTE(s0lly): Library assumes ASCII style strings only, apart from the String_Utf8 / StringUtf8Index functions
 // TODO(s0lly): Ensure that whenever count reduces, "freed" space is cleared to 0 to ensure cstring code works
 // TODO(s0lly): Sift through all integer conversions to ensure correct, limit to int32?
 
@@ -56,6 +56,10 @@ and error 4201 (nameless struct) & error 4820 (struct padding) which I accept as
 // NOTE(s0lly): External dependencies
 
 #define _CRT_SECURE_NO_WARNINGS
+// NOTE(s0lly): -std=c11 hides posix declarations such as clock_gettime unless a feature macro is set
+#if !defined(_WIN32) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
@@ -63,9 +67,80 @@ and error 4201 (nameless struct) & error 4820 (struct padding) which I accept as
 #include <assert.h>
 #include <ctype.h>
 
+// NOTE(s0lly): Vector paths are picked from the compiler's target flags - define SCL_STRING_NO_SIMD to disable them
+#if !defined(SCL_STRING_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCL_STRING_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__) || defined(__AVX__)
+#define SCL_STRING_SSSE3
+#include <tmmintrin.h>
+#endif
+#endif
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <intrin.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <time.h>
+#if defined(__linux__)
+#define SCL_STRING_INOTIFY
+#include <sys/inotify.h>
+#endif
+#endif
+
 
 // NOTE(s0lly): Defines
 
+// NOTE(s0lly): msvc provides these via <stdlib.h>, other compilers do not
+#ifndef min
+#define min(a, b) (((a) < (b)) ? (a) : (b))
+#define SCL_STRING_DEFINED_MIN
+#endif
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#define SCL_STRING_DEFINED_MAX
+#endif
+
+#if defined(__cplusplus)
+#define SCL_STRING_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define SCL_STRING_THREAD_LOCAL __declspec(thread)
+#else
+#define SCL_STRING_THREAD_LOCAL _Thread_local
+#endif
+
+// NOTE(s0lly): Define SCL_STRING_STATS before including this file to enable per-thread call and memory counters.
+// Without it all of the hooks below compile away to nothing.
+#ifdef SCL_STRING_STATS
+#define SCL_STRING_STATS_FUNCTION_COUNT_MAX 256
+#define SCL_STRING_STATS_RECORD(code)                                                      \
+    do                                                                                     \
+    {                                                                                      \
+        static SCL_STRING_THREAD_LOCAL int32_t statsFunctionIndex = -1;                    \
+        if (statsFunctionIndex < 0)                                                        \
+        {                                                                                  \
+            statsFunctionIndex = StringStats_Internal_Register(__func__);                  \
+        }                                                                                  \
+        StringStats_Internal_Record(statsFunctionIndex, (code));                           \
+    } while (0)
+#define SCL_STRING_STATS_MEMMOVE(bytes) (sclStringStats.memmoveBytes += (int64_t)(bytes))
+#define SCL_STRING_STATS_REALLOC(bytes) (sclStringStats.reallocCopyCount++, sclStringStats.reallocCopyBytes += (int64_t)(bytes))
+#else
+#define SCL_STRING_STATS_RECORD(code)
+#define SCL_STRING_STATS_MEMMOVE(bytes)
+#define SCL_STRING_STATS_REALLOC(bytes)
+#endif
 
 
 // NOTE(s0lly): Enums
@@ -91,9 +166,47 @@ typedef enum SCL_STRING_CODE
     SCL_STRING_CODE__COMPARE_LESS_THAN,
     SCL_STRING_CODE__COMPARE_EQUAL,
     SCL_STRING_CODE__COMPARE_GREATER_THAN,
+    SCL_STRING_CODE__ERROR_INVALID_UTF8,
+    SCL_STRING_CODE__ERROR_FILE_WRITE,
+    SCL_STRING_CODE__ERROR_INVALID_SNAPSHOT,
+    SCL_STRING_CODE__ERROR_INVALID_ENCODING,
+    
+    SCL_STRING_CODE__COUNT,
     
 } SCL_STRING_CODE;
 
+typedef enum SCL_STRING_PATTERN_TYPE
+{
+    SCL_STRING_PATTERN_TYPE__GLOB,
+    SCL_STRING_PATTERN_TYPE__REGEX,
+    
+} SCL_STRING_PATTERN_TYPE;
+
+typedef enum SCL_STRING_PATTERN_NODE
+{
+    SCL_STRING_PATTERN_NODE__CHAR,
+    SCL_STRING_PATTERN_NODE__SPLIT,
+    SCL_STRING_PATTERN_NODE__ASSERT_BEGIN,
+    SCL_STRING_PATTERN_NODE__ASSERT_END,
+    SCL_STRING_PATTERN_NODE__MATCH,
+    
+} SCL_STRING_PATTERN_NODE;
+
+typedef enum SCL_STRING_FIND_MODE
+{
+    SCL_STRING_FIND_MODE__OVERLAPPING,
+    SCL_STRING_FIND_MODE__NON_OVERLAPPING,
+    
+} SCL_STRING_FIND_MODE;
+
+typedef enum SCL_STRING_ESCAPE_MODE
+{
+    SCL_STRING_ESCAPE_MODE__CSV,
+    SCL_STRING_ESCAPE_MODE__JSON,
+    SCL_STRING_ESCAPE_MODE__C,
+    
+} SCL_STRING_ESCAPE_MODE;
+
 
 // NOTE(s0lly): Structs
 
@@ -103,6 +216,9 @@ typedef struct String
     int64_t count;
     int64_t countMax;
     
+    // NOTE(s0lly): Non-null when e is a copy-on-write buffer shared with other Strings, see String_Share
+    volatile int64_t *refCount;
+    
 } String;
 
 typedef struct StringMessage
@@ -134,1330 +250,10069 @@ typedef struct StringList
     
 } StringList;
 
+typedef struct StringListFlatEntry
+{
+    int64_t offset;
+    int64_t count;
+    
+} StringListFlatEntry;
 
-// NOTE(s0lly): Helper functions
+// NOTE(s0lly): All contents live NUL-terminated in one pool, indexed by a single entry array
+typedef struct StringListFlat
+{
+    String pool;
+    StringListFlatEntry *entries;
+    int64_t count;
+    int64_t countMax;
+    
+} StringListFlat;
 
-static void Mem_ClearBytes(void *ptr, int64_t bytes)
+// NOTE(s0lly): Sparse codepoint -> byte offset index, see StringUtf8Index_From_String
+typedef struct StringUtf8Index
 {
-    memset(ptr, 0, bytes);
-}
+    int64_t *offsets;
+    int64_t offsetCount;
+    int64_t codepointCount;
+    int64_t byteCount;
+    
+} StringUtf8Index;
+
+typedef struct StringFuzzyMatch
+{
+    int64_t index;
+    int64_t distance;
+    
+} StringFuzzyMatch;
 
+// NOTE(s0lly): Bytes are counted as allocated by Mem_Alloc, including the NUL terminators
+typedef struct StringMemoryUsage
+{
+    int64_t liveBytes;
+    int64_t slackBytes;
+    int64_t allocationCount;
+    int64_t sharedBytes;
+    
+} StringMemoryUsage;
 
-// NOTE(s0lly): String functions
+// NOTE(s0lly): Lines [indexA, indexA + countA) of the old list are replaced by lines [indexB, indexB + countB) of the new
+typedef struct StringDiffEdit
+{
+    int64_t indexA;
+    int64_t countA;
+    int64_t indexB;
+    int64_t countB;
+    
+} StringDiffEdit;
 
-static StringMessage String_Get_Count(String *string)
+// NOTE(s0lly): Edits in ascending order, and copies of the inserted lines in the same order, so that a StringDiff can
+// be applied without the new list
+typedef struct StringDiff
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if(!string->e)
+    StringDiffEdit *e;
+    int64_t count;
+    int64_t countMax;
+    StringList lines;
+    
+} StringDiff;
+
+// NOTE(s0lly): One slot of a StringCounterTable; the token bytes are not NUL-terminated, and count 0 marks an empty slot
+typedef struct StringCounterSlot
+{
+    uint64_t hash;
+    uint8_t *token;
+    int64_t tokenCount;
+    int64_t count;
+    
+} StringCounterSlot;
+
+// NOTE(s0lly): One thread's token counts, as an open addressing table whose token bytes live in blocks that it owns
+typedef struct StringCounterTable
+{
+    StringCounterSlot *slots;
+    int64_t slotCount;
+    int64_t usedCount;
+    int64_t totalCount;
+    int64_t errorBound;
+    
+    uint8_t **blocks;
+    int64_t blockCount;
+    int64_t blockCountMax;
+    int64_t blockUsed;
+    
+} StringCounterTable;
+
+// NOTE(s0lly): Token frequencies, with one table per thread of the pools it has been used with. capacity 0 counts
+// exactly; otherwise each table keeps at most capacity tokens, and counts are lower bounds off by at most errorBound.
+typedef struct StringCounter
+{
+    StringCounterTable *tables;
+    int32_t tableCount;
+    int64_t capacity;
+    uint8_t isDelimiter[256];
+    
+} StringCounter;
+
+// NOTE(s0lly): The true count of token lies within [count, count + error]; error is 0 when counting exactly
+typedef struct StringCounterEntry
+{
+    String token;
+    int64_t count;
+    int64_t error;
+    
+} StringCounterEntry;
+
+// NOTE(s0lly): Result of StringCounter_TopK, ordered by count and then by token. totalCount is the number of tokens
+// counted altogether.
+typedef struct StringCounterEntries
+{
+    StringCounterEntry *e;
+    int64_t count;
+    int64_t totalCount;
+    
+} StringCounterEntries;
+
+// NOTE(s0lly): Growable array of byte offsets into a String, in ascending order
+typedef struct StringPositions
+{
+    int64_t *e;
+    int64_t count;
+    int64_t countMax;
+    
+} StringPositions;
+
+// NOTE(s0lly): Result of StringList_FuzzyFind, ordered by distance and then by index
+typedef struct StringFuzzyMatches
+{
+    StringFuzzyMatch *e;
+    int64_t count;
+    
+} StringFuzzyMatches;
+
+// NOTE(s0lly): One nfa node. CHAR nodes hold a 256 bit byte set, SPLIT nodes with outAlt < 0 are plain links
+typedef struct StringPatternNode
+{
+    uint8_t set[32];
+    SCL_STRING_PATTERN_NODE type;
+    int32_t out;
+    int32_t outAlt;
+    
+} StringPatternNode;
+
+// NOTE(s0lly): One cached dfa state - a sorted set of nfa nodes held in StringPattern.stateNodes
+typedef struct StringPatternState
+{
+    int64_t nodeIndex;
+    int32_t nodeCount;
+    uint32_t hash;
+    int32_t flags;
+    
+} StringPatternState;
+
+// NOTE(s0lly): Compiled pattern, see StringPattern_From_String. The dfa is built lazily while matching, so a
+// pattern must only be used by one thread at a time.
+typedef struct StringPattern
+{
+    StringPatternNode *nodes;
+    int32_t nodeCount;
+    int32_t nodeStart;
+    
+    uint8_t byteClasses[256];
+    uint8_t classBytes[256];
+    int32_t classCount;
+    
+    uint8_t *prefilter;
+    int64_t prefilterCount;
+    
+    StringPatternState *states;
+    int32_t stateCount;
+    int32_t stateCountMax;
+    int32_t stateStart;
+    int32_t *transitions;
+    int32_t *stateTable;
+    int32_t stateTableCount;
+    int32_t *stateNodes;
+    int64_t stateNodeCount;
+    int64_t stateNodeCountMax;
+    
+    int32_t *scratchNodes;
+    int32_t scratchNodeCount;
+    int32_t *scratchStack;
+    uint32_t *scratchMarks;
+    uint32_t scratchGeneration;
+    
+} StringPattern;
+
+// NOTE(s0lly): Platform structs
+
+#if defined(_WIN32)
+typedef HANDLE Platform_Thread;
+typedef SRWLOCK Platform_Mutex;
+typedef CONDITION_VARIABLE Platform_CondVar;
+typedef HANDLE Platform_File;
+typedef HANDLE Platform_Watch;
+#else
+typedef pthread_t Platform_Thread;
+typedef pthread_mutex_t Platform_Mutex;
+typedef pthread_cond_t Platform_CondVar;
+typedef int Platform_File;
+typedef int Platform_Watch;
+#endif
+
+typedef void (*Platform_ThreadFunction)(void *arg);
+
+// NOTE(s0lly): Read-only view of a whole file
+typedef struct Platform_FileMapping
+{
+    uint8_t *data;
+    int64_t count;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+    
+} Platform_FileMapping;
+
+// NOTE(s0lly): device and id together identify a file, so a rename or replacement of a path can be detected
+typedef struct Platform_FileInfo
+{
+    uint64_t device;
+    uint64_t id;
+    int64_t count;
+    
+} Platform_FileInfo;
+
+typedef struct Platform_ThreadStart
+{
+    Platform_ThreadFunction function;
+    void *arg;
+    
+} Platform_ThreadStart;
+
+// NOTE(s0lly): Snapshot file layout: this header, then (count + 1) int64_t blob offsets, then the blob holding every
+// string NUL-terminated. Values are stored in native byte order, and the checksum covers the offsets and the blob.
+typedef struct StringListSnapshotHeader
+{
+    uint8_t magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    int64_t count;
+    int64_t blobCount;
+    uint64_t checksum;
+    uint64_t reserved[3];
+    
+} StringListSnapshotHeader;
+
+// NOTE(s0lly): Read-only list backed by a mapped snapshot file, see StringList_LoadSnapshot
+typedef struct StringListSnapshot
+{
+    Platform_FileMapping mapping;
+    const StringListSnapshotHeader *header;
+    const int64_t *offsets;
+    const uint8_t *blob;
+    int64_t count;
+    
+} StringListSnapshot;
+
+// NOTE(s0lly): Buffered writer over a raw file handle, see FileWriter_From_Filename_String
+typedef struct FileWriter
+{
+    Platform_File handle;
+    uint8_t *buffer;
+    int64_t bufferCount;
+    int64_t bufferCountMax;
+    int64_t byteCount;
+    int32_t isOpen;
+    int32_t hasError;
+    
+} FileWriter;
+
+#define SCL_STRING_READ_AHEAD_SLOT_COUNT 4
+
+// NOTE(s0lly): Background reader filling a ring of buffers, see FileReadAhead_Create. produced and consumed only ever
+// grow - slot i holds chunk i % SCL_STRING_READ_AHEAD_SLOT_COUNT.
+typedef struct FileReadAhead
+{
+    File *file;
+    Platform_Thread thread;
+    Platform_Mutex mutex;
+    Platform_CondVar condVar;
+    
+    uint8_t *slotData[SCL_STRING_READ_AHEAD_SLOT_COUNT];
+    int64_t slotCounts[SCL_STRING_READ_AHEAD_SLOT_COUNT];
+    int64_t slotCountMax;
+    int64_t byteCount;
+    int32_t isHoldingSlot;
+    
+    volatile int64_t produced;
+    volatile int64_t consumed;
+    volatile int64_t finished;
+    volatile int64_t stop;
+    
+} FileReadAhead;
+
+// NOTE(s0lly): Sparse line -> byte offset index over a mapped file, see LineIndex_From_Filename_String
+typedef struct LineIndex
+{
+    Platform_FileMapping mapping;
+    int64_t *offsets;
+    int64_t offsetCount;
+    int64_t count;
+    
+} LineIndex;
+
+// NOTE(s0lly): Layout of a persisted LineIndex: this header followed by offsetCount int64_t offsets
+typedef struct LineIndexHeader
+{
+    uint8_t magic[8];
+    uint32_t version;
+    uint32_t stride;
+    int64_t byteCount;
+    int64_t count;
+    int64_t offsetCount;
+    uint64_t checksum;
+    uint64_t reserved[2];
+    
+} LineIndexHeader;
+
+// NOTE(s0lly): Suffix array and lcp array over a String, see StringIndex_From_String. Entries are int32_t to halve the
+// memory, which limits the text to SCL_STRING_INDEX_COUNT_MAX bytes.
+typedef struct StringIndex
+{
+    String text;
+    const uint8_t *e;
+    int64_t count;
+    int32_t *suffixes;
+    int32_t *lcp;
+    Platform_FileMapping mapping;
+    
+} StringIndex;
+
+// NOTE(s0lly): Layout of a saved StringIndex: this header, the text padded to 8 bytes, then count int32_t suffixes and
+// count int32_t lcp values. The checksum covers the text, suffixes and lcp values.
+typedef struct StringIndexHeader
+{
+    uint8_t magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    int64_t count;
+    uint64_t checksum;
+    uint64_t reserved[4];
+    
+} StringIndexHeader;
+
+// NOTE(s0lly): Incremental reader of a growing file, see FileFollower_From_Filename_String. offset is how far into the
+// current file has been read, and partial holds the bytes after its last newline.
+typedef struct FileFollower
+{
+    String filename;
+    String directory;
+    Platform_File handle;
+    Platform_FileInfo info;
+    Platform_Watch watch;
+    int32_t isOpen;
+    int32_t isWatching;
+    int32_t pollIntervalMs;
+    int64_t offset;
+    String partial;
+    uint8_t *buffer;
+    int64_t bufferCountMax;
+    int64_t rotationCount;
+    int64_t truncationCount;
+    
+} FileFollower;
+
+// NOTE(s0lly): Called with a half-open index range [indexStart, indexEnd) and the index of the worker running it
+typedef void (*StringThreadPoolFunction)(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex);
+
+typedef struct StringThreadPool StringThreadPool;
+
+typedef struct StringThreadPoolWorker
+{
+    StringThreadPool *pool;
+    Platform_Thread thread;
+    int32_t index;
+    
+} StringThreadPoolWorker;
+
+// NOTE(s0lly): Must stay at a fixed address while its threads are running - always use through a pointer
+struct StringThreadPool
+{
+    StringThreadPoolWorker *workers;
+    int32_t workerCount;
+    
+    Platform_Mutex mutex;
+    Platform_CondVar wakeCondVar;
+    Platform_CondVar doneCondVar;
+    int64_t generation;
+    int32_t workersPending;
+    int32_t shutdown;
+    int32_t isRunning;
+    
+    StringThreadPoolFunction function;
+    void *context;
+    int64_t count;
+    int64_t chunkCount;
+    volatile int64_t indexNext;
+    
+};
+
+#ifdef SCL_STRING_STATS
+typedef struct StringStatsFunction
+{
+    const char *name;
+    int64_t calls;
+    int64_t codes[SCL_STRING_CODE__COUNT];
+    
+} StringStatsFunction;
+
+typedef struct StringStats
+{
+    int64_t allocCount;
+    int64_t allocBytes;
+    int64_t freeCount;
+    int64_t freeBytes;
+    int64_t reallocCopyCount;
+    int64_t reallocCopyBytes;
+    int64_t memmoveBytes;
+    int32_t functionCount;
+    StringStatsFunction functions[SCL_STRING_STATS_FUNCTION_COUNT_MAX];
+    
+} StringStats;
+#endif
+
+
+// NOTE(s0lly): Stats functions
+
+#ifdef SCL_STRING_STATS
+// NOTE(s0lly): One set of counters per thread (and per translation unit, as everything here is static)
+static SCL_STRING_THREAD_LOCAL StringStats sclStringStats;
+
+static int32_t StringStats_Internal_Register(const char *functionName)
+{
+    int32_t result = -1;
+    for (int32_t functionIndex = 0; functionIndex < sclStringStats.functionCount; functionIndex++)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        if (strcmp(sclStringStats.functions[functionIndex].name, functionName) == 0)
+        {
+            result = functionIndex;
+            break;
+        }
     }
-    else
+    
+    if (result == -1)
     {
-        msg.int64Val = string->count;
+        if (sclStringStats.functionCount < SCL_STRING_STATS_FUNCTION_COUNT_MAX - 1)
+        {
+            result = sclStringStats.functionCount++;
+            sclStringStats.functions[result].name = functionName;
+        }
+        else
+        {
+            result = SCL_STRING_STATS_FUNCTION_COUNT_MAX - 1;
+            sclStringStats.functions[result].name = "(other)";
+            sclStringStats.functionCount = SCL_STRING_STATS_FUNCTION_COUNT_MAX;
+        }
     }
-    return msg;
+    return result;
 }
 
-static StringMessage String_Get_CountMax(String *string)
+static void StringStats_Internal_Record(int32_t functionIndex, SCL_STRING_CODE code)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if(!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else
+    StringStatsFunction *function = &sclStringStats.functions[functionIndex];
+    function->calls++;
+    if (code >= 0 && code < SCL_STRING_CODE__COUNT)
     {
-        msg.int64Val = string->countMax;
+        function->codes[code]++;
     }
-    return msg;
 }
 
-static StringMessage String_Get_First(String *string)
+static void StringStats_Snapshot(StringStats *dst)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if(!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else if(string->count == 0)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
-    }
-    else
+    if (dst)
     {
-        msg.chPtr = &string->e[0];
+        *dst = sclStringStats;
     }
-    return msg;
 }
 
-static StringMessage String_Get_Last(String *string)
+// NOTE(s0lly): Clears all counters of the calling thread but keeps the registered function names
+static void StringStats_Reset(void)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    sclStringStats.allocCount = 0;
+    sclStringStats.allocBytes = 0;
+    sclStringStats.freeCount = 0;
+    sclStringStats.freeBytes = 0;
+    sclStringStats.reallocCopyCount = 0;
+    sclStringStats.reallocCopyBytes = 0;
+    sclStringStats.memmoveBytes = 0;
+    for (int32_t functionIndex = 0; functionIndex < sclStringStats.functionCount; functionIndex++)
+    {
+        sclStringStats.functions[functionIndex].calls = 0;
+        memset(sclStringStats.functions[functionIndex].codes, 0, sizeof(sclStringStats.functions[functionIndex].codes));
     }
-    else if(!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+}
+
+// NOTE(s0lly): Adds src into dst, matching functions by name - use to combine snapshots taken on several threads
+static void StringStats_Merge(StringStats *dst, StringStats *src)
+{
+    if (dst && src)
+    {
+        dst->allocCount += src->allocCount;
+        dst->allocBytes += src->allocBytes;
+        dst->freeCount += src->freeCount;
+        dst->freeBytes += src->freeBytes;
+        dst->reallocCopyCount += src->reallocCopyCount;
+        dst->reallocCopyBytes += src->reallocCopyBytes;
+        dst->memmoveBytes += src->memmoveBytes;
+        
+        for (int32_t srcIndex = 0; srcIndex < src->functionCount; srcIndex++)
+        {
+            StringStatsFunction *srcFunction = &src->functions[srcIndex];
+            StringStatsFunction *dstFunction = 0;
+            for (int32_t dstIndex = 0; dstIndex < dst->functionCount; dstIndex++)
+            {
+                if (strcmp(dst->functions[dstIndex].name, srcFunction->name) == 0)
+                {
+                    dstFunction = &dst->functions[dstIndex];
+                    break;
+                }
+            }
+            if (!dstFunction && dst->functionCount < SCL_STRING_STATS_FUNCTION_COUNT_MAX)
+            {
+                dstFunction = &dst->functions[dst->functionCount++];
+                dstFunction->name = srcFunction->name;
+            }
+            if (dstFunction)
+            {
+                dstFunction->calls += srcFunction->calls;
+                for (int32_t codeIndex = 0; codeIndex < SCL_STRING_CODE__COUNT; codeIndex++)
+                {
+                    dstFunction->codes[codeIndex] += srcFunction->codes[codeIndex];
+                }
+            }
+        }
     }
-    else if(string->count == 0)
+}
+
+static void StringStats_Print(StringStats *stats, FILE *handle)
+{
+    if (stats && handle)
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        fprintf(handle, "allocs %lld (%lld bytes), frees %lld (%lld bytes), realloc copies %lld (%lld bytes), memmove %lld bytes\n",
+                (long long)stats->allocCount, (long long)stats->allocBytes,
+                (long long)stats->freeCount, (long long)stats->freeBytes,
+                (long long)stats->reallocCopyCount, (long long)stats->reallocCopyBytes,
+                (long long)stats->memmoveBytes);
+        
+        for (int32_t functionIndex = 0; functionIndex < stats->functionCount; functionIndex++)
+        {
+            StringStatsFunction *function = &stats->functions[functionIndex];
+            if (function->calls > 0)
+            {
+                fprintf(handle, "%-48s %12lld calls", function->name, (long long)function->calls);
+                for (int32_t codeIndex = 1; codeIndex < SCL_STRING_CODE__COUNT; codeIndex++)
+                {
+                    if (function->codes[codeIndex] > 0)
+                    {
+                        fprintf(handle, "  code%d:%lld", codeIndex, (long long)function->codes[codeIndex]);
+                    }
+                }
+                fprintf(handle, "\n");
+            }
+        }
     }
-    else
+}
+#endif
+
+
+// NOTE(s0lly): Helper functions
+
+static void Mem_ClearBytes(void *ptr, int64_t bytes)
+{
+    memset(ptr, 0, bytes);
+}
+
+#ifdef SCL_STRING_STATS
+// NOTE(s0lly): Each block carries its size in a 16 byte header so that frees can be counted in bytes
+static void *Mem_Alloc(int64_t count, int64_t elementSize)
+{
+    int64_t bytes = count * elementSize;
+    uint8_t *block = (uint8_t *)calloc(1, bytes + 16);
+    void *result = 0;
+    if (block)
     {
-        msg.chPtr = &string->e[string->count - 1];
+        *(int64_t *)block = bytes;
+        sclStringStats.allocCount++;
+        sclStringStats.allocBytes += bytes;
+        result = block + 16;
     }
-    return msg;
+    return result;
 }
 
-static StringMessage String_Get(String *string, int64_t index)
+static void Mem_Free(void *ptr)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    if (ptr)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+        uint8_t *block = (uint8_t *)ptr - 16;
+        sclStringStats.freeCount++;
+        sclStringStats.freeBytes += *(int64_t *)block;
+        free(block);
+    }
+}
+#else
+static void *Mem_Alloc(int64_t count, int64_t elementSize)
+{
+    return calloc(count, elementSize);
+}
+
+static void Mem_Free(void *ptr)
+{
+    free(ptr);
+}
+#endif
+
+// NOTE(s0lly): Platform functions
+
+#if defined(_WIN32)
+static void Platform_Mutex_Init(Platform_Mutex *mutex) { InitializeSRWLock(mutex); }
+static void Platform_Mutex_Destroy(Platform_Mutex *mutex) { (void)mutex; }
+static void Platform_Mutex_Lock(Platform_Mutex *mutex) { AcquireSRWLockExclusive(mutex); }
+static void Platform_Mutex_Unlock(Platform_Mutex *mutex) { ReleaseSRWLockExclusive(mutex); }
+static void Platform_CondVar_Init(Platform_CondVar *condVar) { InitializeConditionVariable(condVar); }
+static void Platform_CondVar_Destroy(Platform_CondVar *condVar) { (void)condVar; }
+static void Platform_CondVar_Wait(Platform_CondVar *condVar, Platform_Mutex *mutex) { SleepConditionVariableSRW(condVar, mutex, INFINITE, 0); }
+static void Platform_CondVar_Broadcast(Platform_CondVar *condVar) { WakeAllConditionVariable(condVar); }
+
+static int64_t Platform_Atomic_AddInt64(volatile int64_t *value, int64_t amount)
+{
+    return (int64_t)InterlockedExchangeAdd64((volatile LONG64 *)value, (LONG64)amount);
+}
+
+static int64_t Platform_Atomic_LoadInt64(volatile int64_t *value)
+{
+    return (int64_t)InterlockedCompareExchange64((volatile LONG64 *)value, 0, 0);
+}
+
+static void Platform_Atomic_StoreInt64(volatile int64_t *value, int64_t amount)
+{
+    InterlockedExchange64((volatile LONG64 *)value, (LONG64)amount);
+}
+
+static int32_t Platform_CountTrailingZeros32(uint32_t value)
+{
+    unsigned long result = 0;
+    _BitScanForward(&result, value);
+    return (int32_t)result;
+}
+
+static int32_t Platform_PopCount32(uint32_t value)
+{
+    return (int32_t)__popcnt(value);
+}
+
+static int32_t Platform_FileMapping_Open(Platform_FileMapping *fileMapping, const char *filename)
+{
+    int32_t result = 0;
+    Mem_ClearBytes(fileMapping, sizeof(*fileMapping));
+    fileMapping->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (fileMapping->file != INVALID_HANDLE_VALUE)
+    {
+        LARGE_INTEGER fileSize = { 0 };
+        if (GetFileSizeEx(fileMapping->file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            fileMapping->mapping = CreateFileMappingA(fileMapping->file, 0, PAGE_READONLY, 0, 0, 0);
+            if (fileMapping->mapping)
+            {
+                fileMapping->data = (uint8_t *)MapViewOfFile(fileMapping->mapping, FILE_MAP_READ, 0, 0, 0);
+                fileMapping->count = (int64_t)fileSize.QuadPart;
+                result = (fileMapping->data != 0);
+            }
+        }
+        if (!result)
+        {
+            if (fileMapping->mapping)
+            {
+                CloseHandle(fileMapping->mapping);
+            }
+            CloseHandle(fileMapping->file);
+            Mem_ClearBytes(fileMapping, sizeof(*fileMapping));
+        }
+    }
+    return result;
+}
+
+static void Platform_FileMapping_Close(Platform_FileMapping *fileMapping)
+{
+    if (fileMapping->data)
+    {
+        UnmapViewOfFile(fileMapping->data);
+        CloseHandle(fileMapping->mapping);
+        CloseHandle(fileMapping->file);
+    }
+    Mem_ClearBytes(fileMapping, sizeof(*fileMapping));
+}
+
+static int32_t Platform_File_OpenWrite(Platform_File *file, const char *filename)
+{
+    *file = CreateFileA(filename, GENERIC_WRITE, 0, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+    return (*file != INVALID_HANDLE_VALUE);
+}
+
+static int32_t Platform_File_Write(Platform_File file, const uint8_t *data, int64_t count)
+{
+    while (count > 0)
+    {
+        DWORD writtenCount = 0;
+        if (!WriteFile(file, data, (DWORD)min(count, (int64_t)1 << 30), &writtenCount, 0) || writtenCount == 0)
+        {
+            return 0;
+        }
+        data += writtenCount;
+        count -= writtenCount;
+    }
+    return 1;
+}
+
+// NOTE(s0lly): Windows has no gather write for ordinary handles, so this is two calls
+static int32_t Platform_File_WritePair(Platform_File file, const uint8_t *dataA, int64_t countA, const uint8_t *dataB, int64_t countB)
+{
+    return Platform_File_Write(file, dataA, countA) && Platform_File_Write(file, dataB, countB);
+}
+
+static int32_t Platform_File_Sync(Platform_File file)
+{
+    return (FlushFileBuffers(file) != 0);
+}
+
+static int32_t Platform_File_Close(Platform_File file)
+{
+    return (CloseHandle(file) != 0);
+}
+
+// NOTE(s0lly): Shares write and delete access so that the file can still be appended to, renamed or removed
+static int32_t Platform_File_OpenRead(Platform_File *file, const char *filename)
+{
+    *file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, 0, OPEN_EXISTING,
+                        FILE_ATTRIBUTE_NORMAL, 0);
+    return (*file != INVALID_HANDLE_VALUE);
+}
+
+// NOTE(s0lly): Returns the number of bytes read (0 at the end of the file), or -1 on error
+static int64_t Platform_File_ReadAt(Platform_File file, int64_t offset, uint8_t *data, int64_t count)
+{
+    OVERLAPPED overlapped = { 0 };
+    overlapped.Offset = (DWORD)((uint64_t)offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD)((uint64_t)offset >> 32);
+    DWORD readCount = 0;
+    if (!ReadFile(file, data, (DWORD)min(count, (int64_t)1 << 30), &readCount, &overlapped))
+    {
+        return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+    }
+    return (int64_t)readCount;
+}
+
+static int32_t Platform_File_GetInfo(Platform_File file, Platform_FileInfo *info)
+{
+    BY_HANDLE_FILE_INFORMATION fileInformation = { 0 };
+    int32_t result = (GetFileInformationByHandle(file, &fileInformation) != 0);
+    if (result)
+    {
+        info->device = fileInformation.dwVolumeSerialNumber;
+        info->id = ((uint64_t)fileInformation.nFileIndexHigh << 32) | fileInformation.nFileIndexLow;
+        info->count = (int64_t)(((uint64_t)fileInformation.nFileSizeHigh << 32) | fileInformation.nFileSizeLow);
+    }
+    return result;
+}
+
+static int32_t Platform_File_GetInfo_Filename(const char *filename, Platform_FileInfo *info)
+{
+    Platform_File file = 0;
+    int32_t result = 0;
+    if (Platform_File_OpenRead(&file, filename))
+    {
+        result = Platform_File_GetInfo(file, info);
+        CloseHandle(file);
+    }
+    return result;
+}
+
+// NOTE(s0lly): Watches a directory for files being created, renamed, resized or written
+static int32_t Platform_Watch_Open(Platform_Watch *watch, const char *directory)
+{
+    *watch = FindFirstChangeNotificationA(directory, FALSE, FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE |
+                                          FILE_NOTIFY_CHANGE_LAST_WRITE);
+    return (*watch != INVALID_HANDLE_VALUE);
+}
+
+// NOTE(s0lly): Returns 1 if something changed, 0 after timeoutMs without a change
+static int32_t Platform_Watch_Wait(Platform_Watch watch, int32_t timeoutMs)
+{
+    int32_t result = (WaitForSingleObject(watch, (DWORD)timeoutMs) == WAIT_OBJECT_0);
+    if (result)
+    {
+        FindNextChangeNotification(watch);
+    }
+    return result;
+}
+
+static void Platform_Watch_Close(Platform_Watch watch)
+{
+    FindCloseChangeNotification(watch);
+}
+
+static void Platform_Sleep(int32_t timeoutMs)
+{
+    Sleep((DWORD)timeoutMs);
+}
+
+static int64_t Platform_TimeMs(void)
+{
+    return (int64_t)GetTickCount64();
+}
+
+static int32_t Platform_CpuCount(void)
+{
+    SYSTEM_INFO systemInfo = { 0 };
+    GetSystemInfo(&systemInfo);
+    return max((int32_t)systemInfo.dwNumberOfProcessors, 1);
+}
+
+static DWORD WINAPI Platform_Internal_ThreadEntry(LPVOID param)
+{
+    Platform_ThreadStart start = *(Platform_ThreadStart *)param;
+    Mem_Free(param);
+    start.function(start.arg);
+    return 0;
+}
+
+static int32_t Platform_Thread_Create(Platform_Thread *thread, Platform_ThreadFunction function, void *arg)
+{
+    Platform_ThreadStart *start = (Platform_ThreadStart *)Mem_Alloc(1, sizeof(Platform_ThreadStart));
+    start->function = function;
+    start->arg = arg;
+    *thread = CreateThread(0, 0, Platform_Internal_ThreadEntry, start, 0, 0);
+    if (!*thread)
+    {
+        Mem_Free(start);
+    }
+    return *thread != 0;
+}
+
+static void Platform_Thread_Join(Platform_Thread *thread)
+{
+    WaitForSingleObject(*thread, INFINITE);
+    CloseHandle(*thread);
+}
+#else
+static void Platform_Mutex_Init(Platform_Mutex *mutex) { pthread_mutex_init(mutex, 0); }
+static void Platform_Mutex_Destroy(Platform_Mutex *mutex) { pthread_mutex_destroy(mutex); }
+static void Platform_Mutex_Lock(Platform_Mutex *mutex) { pthread_mutex_lock(mutex); }
+static void Platform_Mutex_Unlock(Platform_Mutex *mutex) { pthread_mutex_unlock(mutex); }
+static void Platform_CondVar_Init(Platform_CondVar *condVar) { pthread_cond_init(condVar, 0); }
+static void Platform_CondVar_Destroy(Platform_CondVar *condVar) { pthread_cond_destroy(condVar); }
+static void Platform_CondVar_Wait(Platform_CondVar *condVar, Platform_Mutex *mutex) { pthread_cond_wait(condVar, mutex); }
+static void Platform_CondVar_Broadcast(Platform_CondVar *condVar) { pthread_cond_broadcast(condVar); }
+
+static int64_t Platform_Atomic_AddInt64(volatile int64_t *value, int64_t amount)
+{
+    return __atomic_fetch_add(value, amount, __ATOMIC_SEQ_CST);
+}
+
+static int64_t Platform_Atomic_LoadInt64(volatile int64_t *value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static void Platform_Atomic_StoreInt64(volatile int64_t *value, int64_t amount)
+{
+    __atomic_store_n(value, amount, __ATOMIC_RELEASE);
+}
+
+static int32_t Platform_CountTrailingZeros32(uint32_t value)
+{
+    return __builtin_ctz(value);
+}
+
+static int32_t Platform_PopCount32(uint32_t value)
+{
+    return __builtin_popcount(value);
+}
+
+static int32_t Platform_FileMapping_Open(Platform_FileMapping *fileMapping, const char *filename)
+{
+    int32_t result = 0;
+    Mem_ClearBytes(fileMapping, sizeof(*fileMapping));
+    int fileDescriptor = open(filename, O_RDONLY);
+    if (fileDescriptor >= 0)
+    {
+        struct stat fileStat;
+        if (fstat(fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0)
+        {
+            void *data = mmap(0, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+            if (data != MAP_FAILED)
+            {
+                fileMapping->data = (uint8_t *)data;
+                fileMapping->count = (int64_t)fileStat.st_size;
+                result = 1;
+            }
+        }
+        close(fileDescriptor);
+    }
+    return result;
+}
+
+static void Platform_FileMapping_Close(Platform_FileMapping *fileMapping)
+{
+    if (fileMapping->data)
+    {
+        munmap(fileMapping->data, (size_t)fileMapping->count);
+    }
+    Mem_ClearBytes(fileMapping, sizeof(*fileMapping));
+}
+
+static int32_t Platform_File_OpenWrite(Platform_File *file, const char *filename)
+{
+    *file = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    return (*file >= 0);
+}
+
+static int32_t Platform_File_Write(Platform_File file, const uint8_t *data, int64_t count)
+{
+    while (count > 0)
+    {
+        ssize_t writtenCount = write(file, data, (size_t)min(count, (int64_t)1 << 30));
+        if (writtenCount < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (writtenCount <= 0)
+        {
+            return 0;
+        }
+        data += writtenCount;
+        count -= writtenCount;
+    }
+    return 1;
+}
+
+// NOTE(s0lly): One writev for both ranges, resumed after partial writes
+static int32_t Platform_File_WritePair(Platform_File file, const uint8_t *dataA, int64_t countA, const uint8_t *dataB, int64_t countB)
+{
+    struct iovec vectors[2];
+    vectors[0].iov_base = (void *)dataA;
+    vectors[0].iov_len = (size_t)countA;
+    vectors[1].iov_base = (void *)dataB;
+    vectors[1].iov_len = (size_t)countB;
+    
+    int32_t vectorIndex = (countA > 0) ? 0 : 1;
+    if (countB == 0)
+    {
+        return Platform_File_Write(file, dataA, countA);
+    }
+    while (vectorIndex < 2)
+    {
+        ssize_t writtenCount = writev(file, &vectors[vectorIndex], 2 - vectorIndex);
+        if (writtenCount < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (writtenCount <= 0)
+        {
+            return 0;
+        }
+        while (vectorIndex < 2 && (size_t)writtenCount >= vectors[vectorIndex].iov_len)
+        {
+            writtenCount -= (ssize_t)vectors[vectorIndex].iov_len;
+            vectorIndex++;
+        }
+        if (vectorIndex < 2)
+        {
+            vectors[vectorIndex].iov_base = (uint8_t *)vectors[vectorIndex].iov_base + writtenCount;
+            vectors[vectorIndex].iov_len -= (size_t)writtenCount;
+        }
+    }
+    return 1;
+}
+
+static int32_t Platform_File_Sync(Platform_File file)
+{
+    return (fsync(file) == 0);
+}
+
+static int32_t Platform_File_Close(Platform_File file)
+{
+    return (close(file) == 0);
+}
+
+static int32_t Platform_File_OpenRead(Platform_File *file, const char *filename)
+{
+    *file = open(filename, O_RDONLY);
+    return (*file >= 0);
+}
+
+// NOTE(s0lly): Returns the number of bytes read (0 at the end of the file), or -1 on error. Moves the file position, as
+// pread isn't declared in strict c11 builds.
+static int64_t Platform_File_ReadAt(Platform_File file, int64_t offset, uint8_t *data, int64_t count)
+{
+    ssize_t readCount = -1;
+    if (lseek(file, (off_t)offset, SEEK_SET) == (off_t)offset)
+    {
+        do
+        {
+            readCount = read(file, data, (size_t)min(count, (int64_t)1 << 30));
+        } while (readCount < 0 && errno == EINTR);
+    }
+    return (int64_t)readCount;
+}
+
+static int32_t Platform_File_GetInfo(Platform_File file, Platform_FileInfo *info)
+{
+    struct stat fileStat;
+    int32_t result = (fstat(file, &fileStat) == 0);
+    if (result)
+    {
+        info->device = (uint64_t)fileStat.st_dev;
+        info->id = (uint64_t)fileStat.st_ino;
+        info->count = (int64_t)fileStat.st_size;
+    }
+    return result;
+}
+
+static int32_t Platform_File_GetInfo_Filename(const char *filename, Platform_FileInfo *info)
+{
+    struct stat fileStat;
+    int32_t result = (stat(filename, &fileStat) == 0);
+    if (result)
+    {
+        info->device = (uint64_t)fileStat.st_dev;
+        info->id = (uint64_t)fileStat.st_ino;
+        info->count = (int64_t)fileStat.st_size;
+    }
+    return result;
+}
+
+// NOTE(s0lly): Watches a directory for files being created, moved, deleted or written. Only available with inotify -
+// elsewhere this fails and callers fall back to polling.
+static int32_t Platform_Watch_Open(Platform_Watch *watch, const char *directory)
+{
+    *watch = -1;
+#if defined(SCL_STRING_INOTIFY)
+    *watch = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (*watch >= 0 && inotify_add_watch(*watch, directory, IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                                         IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB) < 0)
+    {
+        close(*watch);
+        *watch = -1;
+    }
+#else
+    (void)directory;
+#endif
+    return (*watch >= 0);
+}
+
+// NOTE(s0lly): Returns 1 if something changed, 0 after timeoutMs without a change. Pending events are drained, as
+// callers only need to know that they should look again.
+static int32_t Platform_Watch_Wait(Platform_Watch watch, int32_t timeoutMs)
+{
+    struct pollfd pollEntry = { 0 };
+    pollEntry.fd = watch;
+    pollEntry.events = POLLIN;
+    int32_t result = (poll(&pollEntry, 1, timeoutMs) > 0);
+    if (result)
+    {
+        uint8_t events[4096];
+        while (read(watch, events, sizeof(events)) > 0)
+        {
+        }
+    }
+    return result;
+}
+
+static void Platform_Watch_Close(Platform_Watch watch)
+{
+    close(watch);
+}
+
+static void Platform_Sleep(int32_t timeoutMs)
+{
+    poll(0, 0, timeoutMs);
+}
+
+// NOTE(s0lly): CLOCK_MONOTONIC is only missing when a system header was included in strict c11 mode before this one
+static int64_t Platform_TimeMs(void)
+{
+    struct timespec now;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+    timespec_get(&now, TIME_UTC);
+#endif
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static int32_t Platform_CpuCount(void)
+{
+    return max((int32_t)sysconf(_SC_NPROCESSORS_ONLN), 1);
+}
+
+static void *Platform_Internal_ThreadEntry(void *param)
+{
+    Platform_ThreadStart start = *(Platform_ThreadStart *)param;
+    Mem_Free(param);
+    start.function(start.arg);
+    return 0;
+}
+
+static int32_t Platform_Thread_Create(Platform_Thread *thread, Platform_ThreadFunction function, void *arg)
+{
+    Platform_ThreadStart *start = (Platform_ThreadStart *)Mem_Alloc(1, sizeof(Platform_ThreadStart));
+    start->function = function;
+    start->arg = arg;
+    int32_t result = (pthread_create(thread, 0, Platform_Internal_ThreadEntry, start) == 0);
+    if (!result)
+    {
+        Mem_Free(start);
+    }
+    return result;
+}
+
+static void Platform_Thread_Join(Platform_Thread *thread)
+{
+    pthread_join(*thread, 0);
+}
+#endif
+
+
+// NOTE(s0lly): Shared buffer functions
+// A shared buffer is one allocation holding the data, then its reference count at the next 8 byte boundary, so that
+// whichever String ends up as the only owner can keep the allocation as an ordinary buffer.
+// A packed block (StringList_Compact) holds the data of many Strings after a header of its reference count and its
+// size in bytes. Its reference count is therefore below the data, which is how the two are told apart.
+
+static inline int32_t String_Internal_IsPacked(String *string)
+{
+    return string->refCount && (uint8_t *)string->refCount < string->e;
+}
+
+// NOTE(s0lly): Drops string's reference, and returns the allocation to free if it was the last one
+static void *String_Internal_Detach(String *string)
+{
+    void *result = 0;
+    if (!string->refCount || Platform_Atomic_AddInt64(string->refCount, -1) == 1)
+    {
+        result = String_Internal_IsPacked(string) ? (void *)string->refCount : (void *)string->e;
+    }
+    return result;
+}
+
+static void String_Internal_Release(String *string)
+{
+    Mem_Free(String_Internal_Detach(string));
+}
+
+// NOTE(s0lly): Gives string a buffer of its own before it is written to. The last owner takes a shared buffer back
+// as it is; any other owner, and any owner of a packed block, copies it.
+// Returns the old allocation if it now has to be freed, which the caller does once it no longer reads from it - the
+// data being written may itself live in the old buffer (e.g. appending a packed String to itself).
+static void *String_Internal_Unshare_Deferred(String *string)
+{
+    void *result = 0;
+    if (string->refCount)
+    {
+        if (Platform_Atomic_LoadInt64(string->refCount) != 1 || String_Internal_IsPacked(string))
+        {
+            uint8_t *eNew = (uint8_t *)Mem_Alloc(string->countMax + 1, sizeof(uint8_t));
+            memcpy(eNew, string->e, string->count);
+            SCL_STRING_STATS_REALLOC(string->count);
+            result = String_Internal_Detach(string);
+            string->e = eNew;
+        }
+        string->refCount = 0;
+    }
+    return result;
+}
+
+static void String_Internal_Unshare(String *string)
+{
+    Mem_Free(String_Internal_Unshare_Deferred(string));
+}
+
+// NOTE(s0lly): Unchecked String functions
+// These do no validation beyond asserts in debug builds, and take and return plain values instead of StringMessage.
+// They are meant for tight loops where the arguments are already known to be valid - the checked String functions
+// below are wrappers around them. They are not recorded by SCL_STRING_STATS.
+
+static inline uint8_t *String_Get_Unchecked(String *string, int64_t index)
+{
+    assert(string && string->e && index >= 0 && index < string->count);
+    return &string->e[index];
+}
+
+static inline void String_Insert_Unchecked(String *string, uint8_t *otherData, int64_t index, int64_t otherCount)
+{
+    assert(string && string->e && index >= 0 && index <= string->count && otherCount >= 0);
+    void *unshared = String_Internal_Unshare_Deferred(string);
+    if (string->count + otherCount > string->countMax)
+    {
+        SCL_STRING_STATS_REALLOC(string->count);
+        SCL_STRING_STATS_MEMMOVE(string->count + otherCount);
+        int64_t countMaxNew = string->count + otherCount;
+        uint8_t *eNew = (uint8_t *)Mem_Alloc(countMaxNew + 1, sizeof(uint8_t));
+        memcpy(eNew, string->e, index);
+        memcpy(eNew + index, otherData, otherCount);
+        memcpy(eNew + index + otherCount, string->e + index, string->count - index);
+        Mem_Free(string->e);
+        string->e = eNew;
+        string->countMax = countMaxNew;
+    }
+    else
+    {
+        memmove(string->e + index + otherCount, string->e + index, string->count - index);
+        memmove(string->e + index, otherData, otherCount);
+        SCL_STRING_STATS_MEMMOVE(string->count - index + otherCount);
+    }
+    string->count += otherCount;
+    Mem_Free(unshared);
+}
+
+static inline void String_Append_Unchecked(String *string, uint8_t *otherData, int64_t otherCount)
+{
+    assert(string && string->e);
+    String_Insert_Unchecked(string, otherData, string->count, otherCount);
+}
+
+// NOTE(s0lly): Returns the index of the first match at or after indexStart, or -1 if there is none
+static inline int64_t String_Find_FirstFrom_Unchecked(String *within, String *toFind, int64_t indexStart)
+{
+    assert(within && within->e && toFind && toFind->e && indexStart >= 0 && indexStart <= within->count);
+    uint8_t *foundPtr = (uint8_t *)strstr((char *)within->e + indexStart, (char *)toFind->e);
+    return foundPtr ? (int64_t)(foundPtr - within->e) : -1;
+}
+
+// NOTE(s0lly): Returns <0, 0 or >0 in the manner of strcmp
+static inline int32_t String_Compare_Unchecked(String *stringA, String *stringB)
+{
+    assert(stringA && stringA->e && stringB && stringB->e);
+    return (int32_t)strcmp((const char *)stringA->e, (const char *)stringB->e);
+}
+
+// NOTE(s0lly): Byte-wise substring search that, unlike strstr, doesn't stop at NUL. With sse2 it compares the first
+// and last needle bytes at 16 positions at once and only runs memcmp on positions where both match.
+static int64_t String_Internal_FindBytes(const uint8_t *data, int64_t count, const uint8_t *needle, int64_t needleCount)
+{
+    if (needleCount <= 0)
+    {
+        return 0;
+    }
+    if (needleCount > count)
+    {
+        return -1;
+    }
+    if (needleCount == 1)
+    {
+        const uint8_t *foundPtr = (const uint8_t *)memchr(data, needle[0], count);
+        return foundPtr ? (int64_t)(foundPtr - data) : -1;
+    }
+    
+    int64_t indexLast = count - needleCount;
+    int64_t index = 0;
+#if defined(SCL_STRING_SSE2)
+    __m128i firstByte = _mm_set1_epi8((char)needle[0]);
+    __m128i lastByte = _mm_set1_epi8((char)needle[needleCount - 1]);
+    while (index + 15 <= indexLast)
+    {
+        __m128i blockFirst = _mm_loadu_si128((const __m128i *)(data + index));
+        __m128i blockLast = _mm_loadu_si128((const __m128i *)(data + index + needleCount - 1));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstByte),
+                                                                  _mm_cmpeq_epi8(blockLast, lastByte)));
+        while (mask)
+        {
+            int64_t candidate = index + Platform_CountTrailingZeros32(mask);
+            if (memcmp(data + candidate + 1, needle + 1, needleCount - 2) == 0)
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        index += 16;
+    }
+#endif
+    for (; index <= indexLast; index++)
+    {
+        if (data[index] == needle[0] && memcmp(data + index + 1, needle + 1, needleCount - 1) == 0)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+
+// NOTE(s0lly): String functions
+
+static StringMessage String_Get_Count(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.int64Val = string->count;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Get_CountMax(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.int64Val = string->countMax;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Get_First(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if(string->count == 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.chPtr = &string->e[0];
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Get_Last(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if(string->count == 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.chPtr = &string->e[string->count - 1];
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Get(String *string, int64_t index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (index < 0 || index >= string->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.chPtr = String_Get_Unchecked(string, index);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_From_CountMax(int64_t countMax)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (countMax < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.string.e = (uint8_t *)Mem_Alloc(countMax + 1, sizeof(msg.string.e[0]));
+        msg.string.countMax = countMax;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Internal_CopyStringIntoMessage(const void *src, int64_t newCount, int64_t newCountMax)
+{
+    StringMessage msg = String_From_CountMax(newCountMax);
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        memmove(msg.string.e, src, newCount);
+        SCL_STRING_STATS_MEMMOVE(newCount);
+        msg.string.count = newCount;
+    }
+    return msg;
+}
+
+static StringMessage String_From_CStr(const char *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Internal_CopyStringIntoMessage((void *)cStr, strlen((const char *)cStr), strlen((const char *)cStr));
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Destroy(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Internal_Release(string);
+        Mem_ClearBytes(string, sizeof(*string));
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_From_String(String *src)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!src)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!src->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (src->refCount)
+    {
+        Platform_Atomic_AddInt64(src->refCount, 1);
+        msg.string = *src;
+    }
+    else
+    {
+        msg = String_Internal_CopyStringIntoMessage(src->e, src->count, src->count);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Moves string into a shared buffer (a single copy, once). From then on String_From_String,
+// StringList_PushCopy and the other copying functions hand out references to it in O(1), and the functions that modify a
+// String give it a private copy first. Writing through the pointers returned by String_Get and friends bypasses this.
+static StringMessage String_Share(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!string->refCount)
+    {
+        int64_t refCountOffset = (string->count + 1 + 7) & ~(int64_t)7;
+        uint8_t *eNew = (uint8_t *)Mem_Alloc(refCountOffset + sizeof(int64_t), sizeof(uint8_t));
+        memcpy(eNew, string->e, string->count);
+        SCL_STRING_STATS_REALLOC(string->count);
+        Mem_Free(string->e);
+        string->e = eNew;
+        string->countMax = string->count;
+        string->refCount = (volatile int64_t *)(eNew + refCountOffset);
+        *string->refCount = 1;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Shares src if it isn't already, and returns another reference to its buffer
+static StringMessage String_From_String_Shared(String *src)
+{
+    StringMessage msg = String_Share(src);
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        msg = String_From_String(src);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_From_SubString(String *string, int64_t indexStartInclusive, int64_t indexEndInclusive)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStartInclusive < 0 || indexStartInclusive >= string->count ||
+             indexEndInclusive < 0 || indexEndInclusive >= string->count ||
+             indexStartInclusive > indexEndInclusive)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else 
+    {
+        msg = String_Internal_CopyStringIntoMessage(string->e + indexStartInclusive,
+                                                    indexEndInclusive - indexStartInclusive + 1,
+                                                    indexEndInclusive - indexStartInclusive + 1);
+        
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_From_int64_t(int64_t val)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    uint8_t tempValString[32];
+    int32_t tempCheck = sprintf((char *)tempValString, "%lld", val);
+    if (tempCheck < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_SPRINTF_CONVERTING_FROM_int64_t_TO_STRING;
+    }
+    else
+    {
+        msg = String_From_CStr((const char *)tempValString);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_From_double(double val)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    uint8_t tempValString[32];
+    int32_t tempCheck = sprintf((char *)tempValString, "%.16f", val);
+    if (tempCheck < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_SPRINTF_CONVERTING_FROM_int64_t_TO_STRING;
+    }
+    else
+    {
+        msg = String_From_CStr((const char *)tempValString);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// TODO(s0lly): Flatten code
+static StringMessage String_From_FileNextLine(File *file)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!file)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if(!file->handle)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t newSize = 256;
+        msg = String_From_CountMax(newSize);
+        
+        int32_t startCursor = file->cursor;
+        int32_t fseekCheck = fseek(file->handle, startCursor, SEEK_SET);
+        
+        uint8_t *fileScanResult = (uint8_t *)fgets((char *)msg.string.e, (uint32_t)msg.string.countMax, file->handle);
+        msg.string.count = strlen((const char *)msg.string.e);
+        if (fileScanResult == 0)
+        {
+            String_Destroy(&msg.string);
+            msg.code = SCL_STRING_CODE__FILE_ENCOUNTERED_EOF;
+            SCL_STRING_STATS_RECORD(msg.code);
+            return msg;
+        }
+        
+        int32_t endCursor = file->cursor + (int32_t)msg.string.count;
+        int32_t cursorDiff = endCursor - startCursor;
+        fseekCheck = fseek(file->handle, endCursor - 1, SEEK_SET);
+        int32_t isLineEnd = (int32_t)fgetc(file->handle);
+        int32_t isEOF = (int32_t)fgetc(file->handle);
+        while(!(isLineEnd == '\n') && !(isEOF == '\0' || isEOF == EOF))
+        {
+            fseekCheck = fseek(file->handle, startCursor, SEEK_SET);
+            newSize = msg.string.countMax * 2;
+            String_Destroy(&msg.string);
+            msg = String_From_CountMax(newSize);
+            fileScanResult = (uint8_t *)fgets((char *)msg.string.e, (int32_t)msg.string.countMax, file->handle);
+            msg.string.count = strlen((const char *)msg.string.e);
+            endCursor = file->cursor + (int32_t)msg.string.count;
+            cursorDiff = endCursor - startCursor;
+            fseekCheck = fseek(file->handle, endCursor - 1, SEEK_SET);
+            isLineEnd = (int32_t)fgetc(file->handle);
+            isEOF = (int32_t)fgetc(file->handle);
+        }
+        
+        file->cursor += (int32_t)msg.string.count;
+        
+        if(*(String_Get_Last(&msg.string)).chPtr == '\n')
+        {
+            *(String_Get_Last(&msg.string)).chPtr = '\0';
+            msg.string.count--;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static void String_Internal_ExtractStringFromMessage(String *dst, StringMessage* msg)
+{
+    *dst = msg->string;
+    Mem_ClearBytes(&msg->string, sizeof(msg->string));
+}
+
+static StringMessage String_Reinit_CountMax(String *string, int64_t countMax)
+{
+    StringMessage msg = String_Destroy(string);
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        msg = String_From_CountMax(countMax);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            String_Internal_ExtractStringFromMessage(string, &msg);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Reinit_CStr(String *string, uint8_t *cStr)
+{
+    StringMessage msg = String_Destroy(string);
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        msg = String_From_CStr((const char *)cStr);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            String_Internal_ExtractStringFromMessage(string, &msg);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Reinit_String(String *string, String *otherString)
+{
+    StringMessage msg = String_Destroy(string);
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        msg = String_From_String(otherString);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            String_Internal_ExtractStringFromMessage(string, &msg);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Reinit_FileNextLine(String *string, File *file)
+{
+    StringMessage msg = String_Destroy(string);
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        msg = String_From_FileNextLine(file);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            String_Internal_ExtractStringFromMessage(string, &msg);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Clear(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Internal_Unshare(string);
+        Mem_ClearBytes(string->e, string->countMax * sizeof(string->e[0]));
+        string->count = 0;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Resize(String *string, int64_t newCountMax)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (newCountMax < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg = String_Reinit_CountMax(string, newCountMax);
+    }
+    else if (newCountMax <= string->countMax)
+    {
+        String_Internal_Unshare(string);
+        string->countMax = newCountMax;
+        string->count = min(string->count, string->countMax);
+        string->e[string->count] = '\0';
+    }
+    else
+    {
+        SCL_STRING_STATS_REALLOC(string->count);
+        msg = String_Internal_CopyStringIntoMessage(string->e, string->count, newCountMax);
+        String_Destroy(string);
+        String_Internal_ExtractStringFromMessage(string, &msg);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_IsEmpty(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.int64Val = (int64_t)(string->count == 0);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Insert_Generic(String *string, uint8_t *otherData, int64_t index, int64_t otherCount)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (index < 0 || index > string->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else if (otherCount <= 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Insert_Unchecked(string, otherData, index, otherCount);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Insert_CStr(String *string, uint8_t *cStr, int64_t index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Insert_Generic(string, cStr, index, strlen((const char *)cStr));
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Insert_uint8_t(String *string, uint8_t ch, int64_t index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (ch == '\0')
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_CHARACTER_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Insert_Generic(string, &ch, index, 1);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Insert_String(String *string, String *otherString, int64_t index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Insert_Generic(string, otherString->e, index, otherString->count);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Append_Generic(String *string, uint8_t *otherData, int64_t otherCount)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
     else if(!string->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (index < 0 || index >= string->count)
+    else
+    {
+        msg = String_Insert_Generic(string, otherData, string->count, otherCount);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Append_CStr(String *string, uint8_t *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Append_Generic(string, cStr, strlen((const char *)cStr));
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Append_uint8_t(String *string, uint8_t ch)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (ch == '\0')
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_CHARACTER_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Append_Generic(string, &ch, 1);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Append_String(String *string, String *otherString)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!otherString)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!otherString->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Append_Generic(string, otherString->e, otherString->count);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Sums all counts first so that the result is allocated exactly once
+static StringMessage String_Concat_Many(String **strings, int64_t stringCount)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!strings)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (stringCount < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t totalCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringCount; stringIndex++)
+        {
+            if (!strings[stringIndex])
+            {
+                msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+                break;
+            }
+            else if (!strings[stringIndex]->e)
+            {
+                msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+                break;
+            }
+            totalCount += strings[stringIndex]->count;
+        }
+
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = String_From_CountMax(totalCount);
+            if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+            {
+                uint8_t *dst = msg.string.e;
+                for (int64_t stringIndex = 0; stringIndex < stringCount; stringIndex++)
+                {
+                    memcpy(dst, strings[stringIndex]->e, strings[stringIndex]->count);
+                    dst += strings[stringIndex]->count;
+                }
+                msg.string.count = totalCount;
+            }
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Compare(String *stringA, String *stringB)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!stringA || !stringB)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if(!stringA->e || !stringB->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int32_t compVal = String_Compare_Unchecked(stringA, stringB);
+        if (compVal == 0)
+        {
+            msg.code = SCL_STRING_CODE__COMPARE_EQUAL;
+        }
+        else if(compVal < 0)
+        {
+            msg.code = SCL_STRING_CODE__COMPARE_LESS_THAN;
+        }
+        else
+        {
+            msg.code = SCL_STRING_CODE__COMPARE_GREATER_THAN;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage int64_t_From_String(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.int64Val = atoi((const char *)string->e);
+        StringMessage tempIntValString = String_From_CountMax(string->count);
+        sprintf((char *)tempIntValString.string.e, "%lld", msg.int64Val);
+        if (String_Compare(&tempIntValString.string, string).code == SCL_STRING_CODE__COMPARE_EQUAL)
+        {
+            msg.code = SCL_STRING_CODE__NO_MESSAGE;
+        }
+        else
+        {
+            msg.code = SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_int64_t;
+        }
+        String_Destroy(&tempIntValString.string);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// TODO(s0lly): Reorder elses
+static StringMessage double_From_String(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.doubleVal = atof((const char *)string->e);
+        
+        int32_t encounteredDot = 0;
+        int32_t countDots = 0;
+        int32_t countNumsBeforeDot = 0;
+        int32_t countNumsAfterDot = 0;
+        int32_t encounteredMinusFirst = 0;
+        int32_t countMinus = 0;
+        int32_t countOther = 0;
+        
+        int64_t segmentIndex = 0;
+        while (segmentIndex < string->count)
+        {
+            uint8_t currentChar = string->e[segmentIndex];
+            if (currentChar == '.')
+            {
+                countDots++;
+                encounteredDot = 1;
+            }
+            else if (currentChar >= '0' && currentChar <= '9')
+            {
+                if (encounteredDot == 0)
+                {
+                    countNumsBeforeDot++;
+                }
+                else
+                {
+                    countNumsAfterDot++;
+                }
+            }
+            else if (currentChar == '-')
+            {
+                countMinus++;
+                if (segmentIndex == 0)
+                {
+                    encounteredMinusFirst = 1;
+                }
+            }
+            else
+            {
+                countOther++;
+            }
+            
+            segmentIndex++;
+        }
+        
+        if (!(countDots == 1 && countOther == 0 &&
+              countNumsBeforeDot >= 0 && countNumsAfterDot >= 0 &&
+              countNumsBeforeDot + countNumsAfterDot > 0 &&
+              ((countMinus == 0 && !encounteredMinusFirst) || (countMinus == 1 && encounteredMinusFirst))))
+            // Must be in format [dddd].[dddd] i.e. numbers either or both before and after '.',
+            //     but at least one numeric value somewhere
+        {
+            msg.code = SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_double;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Remove(String *string, int64_t indexStartInclusive, int64_t indexEndInclusive)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStartInclusive < 0 || indexStartInclusive >= string->count ||
+             indexEndInclusive < 0 || indexEndInclusive >= string->count ||
+             indexStartInclusive > indexEndInclusive)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Internal_Unshare(string);
+        int64_t originalCount = string->count;
+        memmove(string->e + indexStartInclusive, string->e + indexEndInclusive + 1, string->count - (indexEndInclusive + 1));
+        SCL_STRING_STATS_MEMMOVE(string->count - (indexEndInclusive + 1));
+        string->count = string->count - (indexEndInclusive - indexStartInclusive + 1);
+        Mem_ClearBytes(string->e + string->count, originalCount - string->count);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Remove_WhitespacePrecending(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t indexFirstNonWhitespace = -1;
+        for (int64_t strIndex = 0; strIndex < string->count; strIndex++)
+        {
+            if (string->e[strIndex] != ' ')
+            {
+                indexFirstNonWhitespace = strIndex;
+                break;
+            }
+        }
+        
+        if (indexFirstNonWhitespace != 0)
+        {
+            String_Internal_Unshare(string);
+        }
+        if (indexFirstNonWhitespace > 0)
+        {
+            memmove(string->e, string->e + indexFirstNonWhitespace, string->count - indexFirstNonWhitespace);
+            SCL_STRING_STATS_MEMMOVE(string->count - indexFirstNonWhitespace);
+            int64_t originalCount = string->count;
+            string->count = string->count - indexFirstNonWhitespace;
+            Mem_ClearBytes(string->e + string->count, originalCount - string->count);
+        }
+        else if (indexFirstNonWhitespace == -1)
+        {
+            int64_t originalCount = string->count;
+            string->count = 0;
+            Mem_ClearBytes(string->e, originalCount);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Remove_WhitespaceFollowing(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t indexLastNonWhitespace = -1;
+        for (int64_t strIndex = string->count - 1; strIndex >= 0; strIndex--)
+        {
+            if (string->e[strIndex] != ' ')
+            {
+                indexLastNonWhitespace = strIndex;
+                break;
+            }
+        }
+        
+        if (indexLastNonWhitespace < string->count - 1)
+        {
+            String_Internal_Unshare(string);
+        }
+        if (indexLastNonWhitespace >= 0 && indexLastNonWhitespace < string->count - 1)
+        {
+            int64_t originalCount = string->count;
+            string->count = indexLastNonWhitespace + 1;
+            Mem_ClearBytes(string->e + string->count, originalCount - string->count);
+        }
+        else if (indexLastNonWhitespace == -1)
+        {
+            int64_t originalCount = string->count;
+            string->count = 0;
+            Mem_ClearBytes(string->e, originalCount);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Remove_WhitespaceSurrounding(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Remove_WhitespacePrecending(string);
+        String_Remove_WhitespaceFollowing(string);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_ToUpper(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Internal_Unshare(string);
+        for (int64_t strIndex = 0; strIndex < string->count; strIndex++)
+        {
+            uint8_t *currentCh = String_Get_Unchecked(string, strIndex);
+            *currentCh = (uint8_t)toupper(*currentCh);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_ToLower(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Internal_Unshare(string);
+        for (int64_t strIndex = 0; strIndex < string->count; strIndex++)
+        {
+            uint8_t *currentCh = String_Get_Unchecked(string, strIndex);
+            *currentCh = (uint8_t)tolower(*currentCh);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Find_FirstFrom(String *within, String *toFind, int64_t indexStart)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!within || !toFind)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!within->e || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStart < 0 || indexStart >= within->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t foundIndex = String_Find_FirstFrom_Unchecked(within, toFind, indexStart);
+        if (foundIndex < 0)
+        {
+            msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
+        }
+        else
+        {
+            msg.int64Val = foundIndex;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Find_LastFrom(String *within, String *toFind, int64_t indexStart)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!within || !toFind)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!within->e || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStart < 0 || indexStart >= within->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        // NOTE(s0lly): One pass, resuming the byte search just after each match
+        int64_t foundIndex = -1;
+        int64_t index = indexStart;
+        int64_t hitIndex = 0;
+        while (index < within->count
+               && (hitIndex = String_Internal_FindBytes(within->e + index, within->count - index, toFind->e, toFind->count)) >= 0)
+        {
+            foundIndex = index + hitIndex;
+            index = foundIndex + 1;
+        }
+        
+        if (foundIndex < 0)
+        {
+            msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
+        }
+        else
+        {
+            msg.int64Val = foundIndex;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_Replace(String *string, String *newContents,
+                                    int64_t indexStartInclusive, int64_t indexEndInclusive)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStartInclusive < 0 || indexStartInclusive >= string->count ||
+             indexEndInclusive < 0 || indexEndInclusive >= string->count ||
+             indexStartInclusive > indexEndInclusive)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Remove(string, indexStartInclusive, indexEndInclusive);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = String_Insert_String(string, newContents, indexStartInclusive);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_FindReplaceFrom(String *string, String *oldContents, String *newContents, int64_t indexStart)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !oldContents || !newContents)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e || !oldContents->e || !newContents->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStart < 0 || indexStart >= string->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Find_FirstFrom(string, oldContents, indexStart);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            int64_t firstFind = msg.int64Val;
+            msg = String_Replace(string, newContents, firstFind, firstFind + oldContents->count - 1);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_FindReplaceFrom_All(String *string, String *oldContents, String *newContents,
+                                                int64_t indexStart)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !oldContents || !newContents)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e || !oldContents->e || !newContents->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStart < 0 || indexStart >= string->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int32_t replacedAny = 0;
+        msg = String_Find_FirstFrom(string, oldContents, indexStart);
+        while(msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            int64_t firstFind = msg.int64Val;
+            msg = String_Replace(string, newContents, firstFind, firstFind + oldContents->count - 1);
+            if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+            {
+                // NOTE(s0lly): Continue searching after the inserted contents, never inside them
+                replacedAny = 1;
+                int64_t indexNext = firstFind + newContents->count;
+                if (indexNext >= string->count)
+                {
+                    break;
+                }
+                msg = String_Find_FirstFrom(string, oldContents, indexNext);
+            }
+        }
+
+        if (msg.code == SCL_STRING_CODE__FIND_NO_MATCH && replacedAny)
+        {
+            msg.code = SCL_STRING_CODE__NO_MESSAGE;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): UTF-8 functions
+
+#define SCL_STRING_UTF8_INDEX_STRIDE 64
+
+static int32_t String_Internal_Utf8_IsContinuation(uint8_t ch)
+{
+    return (ch & 0xC0) == 0x80;
+}
+
+// NOTE(s0lly): Returns the byte count of the valid sequence starting at index, or 0 if it is invalid
+static inline int64_t String_Internal_Utf8_SequenceCount(const uint8_t *data, int64_t index, int64_t count)
+{
+    uint8_t ch = data[index];
+    int64_t sequenceCount = 0;
+    uint8_t minSecond = 0x80;
+    uint8_t maxSecond = 0xBF;
+    if (ch < 0x80)
+    {
+        return 1;
+    }
+    else if (ch >= 0xC2 && ch <= 0xDF)
+    {
+        sequenceCount = 2;
+    }
+    else if (ch >= 0xE0 && ch <= 0xEF)
+    {
+        sequenceCount = 3;
+        minSecond = (ch == 0xE0) ? 0xA0 : 0x80;
+        maxSecond = (ch == 0xED) ? 0x9F : 0xBF;
+    }
+    else if (ch >= 0xF0 && ch <= 0xF4)
+    {
+        sequenceCount = 4;
+        minSecond = (ch == 0xF0) ? 0x90 : 0x80;
+        maxSecond = (ch == 0xF4) ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 0;
+    }
+    
+    if (index + sequenceCount > count || data[index + 1] < minSecond || data[index + 1] > maxSecond)
+    {
+        return 0;
+    }
+    for (int64_t continuationIndex = 2; continuationIndex < sequenceCount; continuationIndex++)
+    {
+        if (!String_Internal_Utf8_IsContinuation(data[index + continuationIndex]))
+        {
+            return 0;
+        }
+    }
+    return sequenceCount;
+}
+
+// NOTE(s0lly): Returns the offset of the first byte that is not part of a valid sequence, or count if all valid
+static int64_t String_Internal_Utf8_ValidateScalar(const uint8_t *data, int64_t indexStart, int64_t count)
+{
+    int64_t index = indexStart;
+    while (index < count)
+    {
+        int64_t sequenceCount = String_Internal_Utf8_SequenceCount(data, index, count);
+        if (sequenceCount == 0)
+        {
+            break;
+        }
+        index += sequenceCount;
+    }
+    return index;
+}
+
+#if defined(SCL_STRING_SSSE3)
+// NOTE(s0lly): Lookup table validation after Keiser & Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+// Each byte pair is classified by three 16-entry tables indexed by nibbles; any bit surviving the AND is an error.
+#define SCL_UTF8_TOO_SHORT      (1 << 0)
+#define SCL_UTF8_TOO_LONG       (1 << 1)
+#define SCL_UTF8_OVERLONG_3     (1 << 2)
+#define SCL_UTF8_TOO_LARGE      (1 << 3)
+#define SCL_UTF8_SURROGATE      (1 << 4)
+#define SCL_UTF8_OVERLONG_2     (1 << 5)
+#define SCL_UTF8_TOO_LARGE_1000 (1 << 6)
+#define SCL_UTF8_OVERLONG_4     (1 << 6)
+#define SCL_UTF8_TWO_CONTS      (1 << 7)
+#define SCL_UTF8_CARRY          (SCL_UTF8_TOO_SHORT | SCL_UTF8_TOO_LONG | SCL_UTF8_TWO_CONTS)
+
+static __m128i String_Internal_Utf8_CheckBlock(__m128i input, __m128i prevInput)
+{
+    const __m128i byte1HighTable = _mm_setr_epi8(
+        SCL_UTF8_TOO_LONG, SCL_UTF8_TOO_LONG, SCL_UTF8_TOO_LONG, SCL_UTF8_TOO_LONG,
+        SCL_UTF8_TOO_LONG, SCL_UTF8_TOO_LONG, SCL_UTF8_TOO_LONG, SCL_UTF8_TOO_LONG,
+        (char)SCL_UTF8_TWO_CONTS, (char)SCL_UTF8_TWO_CONTS, (char)SCL_UTF8_TWO_CONTS, (char)SCL_UTF8_TWO_CONTS,
+        SCL_UTF8_TOO_SHORT | SCL_UTF8_OVERLONG_2,
+        SCL_UTF8_TOO_SHORT,
+        SCL_UTF8_TOO_SHORT | SCL_UTF8_OVERLONG_3 | SCL_UTF8_SURROGATE,
+        SCL_UTF8_TOO_SHORT | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000 | SCL_UTF8_OVERLONG_4);
+    
+    const __m128i byte1LowTable = _mm_setr_epi8(
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_OVERLONG_3 | SCL_UTF8_OVERLONG_2 | SCL_UTF8_OVERLONG_4),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_OVERLONG_2),
+        (char)SCL_UTF8_CARRY,
+        (char)SCL_UTF8_CARRY,
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000 | SCL_UTF8_SURROGATE),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000),
+        (char)(SCL_UTF8_CARRY | SCL_UTF8_TOO_LARGE | SCL_UTF8_TOO_LARGE_1000));
+    
+    const __m128i byte2HighTable = _mm_setr_epi8(
+        SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT,
+        SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT,
+        (char)(SCL_UTF8_TOO_LONG | SCL_UTF8_OVERLONG_2 | SCL_UTF8_TWO_CONTS | SCL_UTF8_OVERLONG_3 |
+               SCL_UTF8_TOO_LARGE_1000 | SCL_UTF8_OVERLONG_4),
+        (char)(SCL_UTF8_TOO_LONG | SCL_UTF8_OVERLONG_2 | SCL_UTF8_TWO_CONTS | SCL_UTF8_OVERLONG_3 | SCL_UTF8_TOO_LARGE),
+        (char)(SCL_UTF8_TOO_LONG | SCL_UTF8_OVERLONG_2 | SCL_UTF8_TWO_CONTS | SCL_UTF8_SURROGATE | SCL_UTF8_TOO_LARGE),
+        (char)(SCL_UTF8_TOO_LONG | SCL_UTF8_OVERLONG_2 | SCL_UTF8_TWO_CONTS | SCL_UTF8_SURROGATE | SCL_UTF8_TOO_LARGE),
+        SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT, SCL_UTF8_TOO_SHORT);
+    
+    const __m128i lowNibbleMask = _mm_set1_epi8(0x0F);
+    __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+    __m128i byte1High = _mm_shuffle_epi8(byte1HighTable, _mm_and_si128(_mm_srli_epi16(prev1, 4), lowNibbleMask));
+    __m128i byte1Low = _mm_shuffle_epi8(byte1LowTable, _mm_and_si128(prev1, lowNibbleMask));
+    __m128i byte2High = _mm_shuffle_epi8(byte2HighTable, _mm_and_si128(_mm_srli_epi16(input, 4), lowNibbleMask));
+    __m128i specialCases = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+    
+    // NOTE(s0lly): Third and fourth bytes of 3 and 4 byte sequences must be continuations - only those leads
+    // survive the saturating subtractions with the top bit set
+    __m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+    __m128i isThirdByte = _mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80)));
+    __m128i isFourthByte = _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80)));
+    __m128i must23 = _mm_and_si128(_mm_or_si128(isThirdByte, isFourthByte), _mm_set1_epi8((char)0x80));
+    
+    return _mm_xor_si128(must23, specialCases);
+}
+
+static __m128i String_Internal_Utf8_IsIncomplete(__m128i input)
+{
+    const __m128i maxValue = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                           (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    return _mm_subs_epu8(input, maxValue);
+}
+#endif
+
+// NOTE(s0lly): Returns the offset of the first invalid byte, or count if the whole range is valid UTF-8
+static int64_t String_Internal_Utf8_Validate(const uint8_t *data, int64_t count)
+{
+    int64_t index = 0;
+#if defined(SCL_STRING_SSSE3)
+    __m128i prevInput = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+    __m128i error = _mm_setzero_si128();
+    while (index + 16 <= count)
+    {
+        __m128i input = _mm_loadu_si128((const __m128i *)(data + index));
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            error = _mm_or_si128(error, prevIncomplete);
+            prevIncomplete = _mm_setzero_si128();
+        }
+        else
+        {
+            error = _mm_or_si128(error, String_Internal_Utf8_CheckBlock(input, prevInput));
+            prevIncomplete = String_Internal_Utf8_IsIncomplete(input);
+        }
+        prevInput = input;
+        
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+        index += 16;
+    }
+    
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+    {
+        // NOTE(s0lly): Everything before the previous block is known valid - rescan from there to pinpoint the error
+        index = max(index - 16, 0);
+        for (int32_t backCount = 0; backCount < 3 && index > 0 && String_Internal_Utf8_IsContinuation(data[index]); backCount++)
+        {
+            index--;
+        }
+    }
+    else if (index > 0)
+    {
+        // NOTE(s0lly): The last block may end mid-sequence, so finish from the start of its last sequence
+        int64_t sequenceStart = index - 1;
+        for (int32_t backCount = 0; backCount < 3 && sequenceStart > 0 && String_Internal_Utf8_IsContinuation(data[sequenceStart]); backCount++)
+        {
+            sequenceStart--;
+        }
+        if (data[sequenceStart] >= 0x80)
+        {
+            index = sequenceStart;
+        }
+    }
+#elif defined(SCL_STRING_SSE2)
+    // NOTE(s0lly): Without ssse3 only runs of ascii are skipped 16 bytes at a time, other blocks are decoded
+    while (index + 16 <= count)
+    {
+        if (_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(data + index))) == 0)
+        {
+            index += 16;
+        }
+        else
+        {
+            // NOTE(s0lly): Stay on the scalar path until the text drops back into ascii
+            int64_t indexBlockEnd = index + 16;
+            int64_t sequenceCount = 1;
+            while (index < count && (index < indexBlockEnd || data[index] >= 0x80) && sequenceCount > 0)
+            {
+                sequenceCount = String_Internal_Utf8_SequenceCount(data, index, count);
+                index += sequenceCount;
+            }
+            if (sequenceCount == 0)
+            {
+                break;
+            }
+        }
+    }
+#endif
+    return String_Internal_Utf8_ValidateScalar(data, index, count);
+}
+
+// NOTE(s0lly): On invalid input, int64Val holds the byte offset of the first invalid sequence
+static StringMessage String_Utf8_Validate(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t invalidIndex = String_Internal_Utf8_Validate(string->e, string->count);
+        if (invalidIndex < string->count)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_INVALID_UTF8;
+            msg.int64Val = invalidIndex;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Counts the bytes that are not continuation bytes, which equals the codepoint count of valid UTF-8
+static int64_t String_Internal_Utf8_Count(const uint8_t *data, int64_t count)
+{
+    int64_t result = 0;
+    int64_t index = 0;
+#if defined(SCL_STRING_SSE2)
+    const __m128i continuationMax = _mm_set1_epi8((char)0xBF);
+    while (index + 16 <= count)
+    {
+        // NOTE(s0lly): Per-lane counters are flushed with a sum of absolute differences before they can overflow
+        __m128i lanes = _mm_setzero_si128();
+        int64_t blockCount = min((count - index) / 16, 255);
+        for (int64_t blockIndex = 0; blockIndex < blockCount; blockIndex++)
+        {
+            __m128i input = _mm_loadu_si128((const __m128i *)(data + index));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpgt_epi8(input, continuationMax));
+            index += 16;
+        }
+        __m128i sums = _mm_sad_epu8(lanes, _mm_setzero_si128());
+        result += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+#endif
+    for (; index < count; index++)
+    {
+        result += !String_Internal_Utf8_IsContinuation(data[index]);
+    }
+    return result;
+}
+
+static StringMessage String_Utf8_Count(String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.int64Val = String_Internal_Utf8_Count(string->e, string->count);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static void StringUtf8Index_Destroy(StringUtf8Index *index)
+{
+    if (index)
+    {
+        Mem_Free(index->offsets);
+        Mem_ClearBytes(index, sizeof(*index));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Records the byte offset of every SCL_STRING_UTF8_INDEX_STRIDE-th codepoint. The index refers to
+// the string's contents at build time and must be rebuilt after the string is modified.
+static StringUtf8Index StringUtf8Index_From_String(String *string)
+{
+    StringUtf8Index result = { 0 };
+    if (string && string->e)
+    {
+        result.codepointCount = String_Internal_Utf8_Count(string->e, string->count);
+        result.offsetCount = result.codepointCount / SCL_STRING_UTF8_INDEX_STRIDE + 1;
+        result.offsets = (int64_t *)Mem_Alloc(result.offsetCount, sizeof(int64_t));
+        result.byteCount = string->count;
+        
+        int64_t codepointIndex = 0;
+        for (int64_t byteIndex = 0; byteIndex < string->count; byteIndex++)
+        {
+            if (!String_Internal_Utf8_IsContinuation(string->e[byteIndex]))
+            {
+                if (codepointIndex % SCL_STRING_UTF8_INDEX_STRIDE == 0)
+                {
+                    result.offsets[codepointIndex / SCL_STRING_UTF8_INDEX_STRIDE] = byteIndex;
+                }
+                codepointIndex++;
+            }
+        }
+        if (result.codepointCount % SCL_STRING_UTF8_INDEX_STRIDE == 0)
+        {
+            result.offsets[result.offsetCount - 1] = string->count;
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): codepointIndex may equal the codepoint count, giving the byte count (one past the end)
+static StringMessage StringUtf8Index_ByteOffset(StringUtf8Index *index, String *string, int64_t codepointIndex)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index || !string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->offsets || !string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (codepointIndex < 0 || codepointIndex > index->codepointCount || string->count != index->byteCount)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t byteIndex = index->offsets[codepointIndex / SCL_STRING_UTF8_INDEX_STRIDE];
+        int64_t remaining = codepointIndex % SCL_STRING_UTF8_INDEX_STRIDE;
+        while (remaining > 0)
+        {
+            byteIndex++;
+            while (byteIndex < string->count && String_Internal_Utf8_IsContinuation(string->e[byteIndex]))
+            {
+                byteIndex++;
+            }
+            remaining--;
+        }
+        msg.int64Val = byteIndex;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Returns the index of the codepoint containing byteIndex
+static StringMessage StringUtf8Index_CodepointIndex(StringUtf8Index *index, String *string, int64_t byteIndex)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index || !string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->offsets || !string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (byteIndex < 0 || byteIndex >= string->count || string->count != index->byteCount)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t low = 0;
+        int64_t high = (index->codepointCount - 1) / SCL_STRING_UTF8_INDEX_STRIDE;
+        while (low < high)
+        {
+            int64_t middle = low + (high - low + 1) / 2;
+            if (index->offsets[middle] <= byteIndex)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle - 1;
+            }
+        }
+        int64_t byteStart = index->offsets[low];
+        msg.int64Val = low * SCL_STRING_UTF8_INDEX_STRIDE +
+            String_Internal_Utf8_Count(string->e + byteStart, byteIndex + 1 - byteStart) - 1;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Codepoint based counterpart of String_From_SubString
+static StringMessage String_From_SubString_Utf8(String *string, StringUtf8Index *index,
+                                                int64_t codepointStartInclusive, int64_t codepointEndInclusive)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (codepointStartInclusive < 0 || codepointEndInclusive >= index->codepointCount ||
+             codepointStartInclusive > codepointEndInclusive)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        StringMessage startMsg = StringUtf8Index_ByteOffset(index, string, codepointStartInclusive);
+        StringMessage endMsg = StringUtf8Index_ByteOffset(index, string, codepointEndInclusive + 1);
+        if (startMsg.code != SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = startMsg;
+        }
+        else if (endMsg.code != SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = endMsg;
+        }
+        else
+        {
+            msg = String_From_SubString(string, startMsg.int64Val, endMsg.int64Val - 1);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+
+// NOTE(s0lly): StringList functions
+
+static String *StringList_Get(StringList *stringList, int64_t index)
+{
+    String *result = 0;
+    if (stringList && stringList->e && index >= 0 && index < stringList->count)
+    {
+        result = &stringList->e[index];
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static void StringList_Destroy(StringList *stringList)
+{
+    if (stringList)
+    {
+        if (stringList->e)
+        {
+            for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+            {
+                String *currentString = StringList_Get(stringList, stringIndex);
+                if (currentString && currentString->e)
+                {
+                    String_Destroy(currentString);
+                }
+            }
+            Mem_Free(stringList->e);
+        }
+        Mem_ClearBytes(stringList, sizeof(*stringList));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static StringList StringList_From_CountMax(int64_t countMax)
+{
+    StringList result = { 0 };
+    if (countMax > 0)
+    {
+        result.countMax = countMax;
+        result.e = (String *)Mem_Alloc(result.countMax, sizeof(String));
+        
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static void StringList_Resize(StringList *stringList, int64_t countMaxNew)
+{
+    if (countMaxNew > 0)
+    {
+        if (stringList && stringList->e)
+        {
+            // NOTE(s0lly): The String structs are moved across, so their contents are never copied
+            StringList result = StringList_From_CountMax(countMaxNew);
+            result.count = min(countMaxNew, stringList->count);
+            SCL_STRING_STATS_REALLOC(result.count * sizeof(String));
+            memcpy(result.e, stringList->e, result.count * sizeof(String));
+            for (int64_t stringIndex = result.count; stringIndex < stringList->count; stringIndex++)
+            {
+                String_Destroy(&stringList->e[stringIndex]);
+            }
+            Mem_Free(stringList->e);
+            *stringList = result;
+        }
+        else
+        {
+            *stringList = StringList_From_CountMax(countMaxNew);
+        }
+    }
+    else
+    {
+        StringList_Destroy(stringList);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static void StringList_PushCopy(StringList *stringList, String *string)
+{
+    if (stringList && string)
+    {
+        if (stringList->e)
+        {
+            if (stringList->count >= stringList->countMax)
+            {
+                StringList_Resize(stringList, stringList->countMax * 2);
+            }
+        }
+        else
+        {
+            *stringList = StringList_From_CountMax(1);
+        }
+        
+        stringList->e[stringList->count] = String_From_String(string).string;
+        stringList->count++;
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Sums all counts first so that the result is allocated exactly once
+static StringMessage StringList_Join(StringList *stringList, String *separator)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!stringList || !separator)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!separator->e || (stringList->count > 0 && !stringList->e))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t totalCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            String *currentString = StringList_Get(stringList, stringIndex);
+            if (!currentString->e)
+            {
+                msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+                break;
+            }
+            totalCount += currentString->count;
+        }
+        if (stringList->count > 1)
+        {
+            totalCount += separator->count * (stringList->count - 1);
+        }
+
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = String_From_CountMax(totalCount);
+            if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+            {
+                uint8_t *dst = msg.string.e;
+                for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+                {
+                    String *currentString = StringList_Get(stringList, stringIndex);
+                    if (stringIndex > 0)
+                    {
+                        memcpy(dst, separator->e, separator->count);
+                        dst += separator->count;
+                    }
+                    memcpy(dst, currentString->e, currentString->count);
+                    dst += currentString->count;
+                }
+                msg.string.count = totalCount;
+            }
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringList StringList_From_String_SplitByDelimiters(String *string, String *delimiters, String *ignoreChs)
+{
+    StringList result = { 0 };
+    if (string && string->e && delimiters && delimiters->e && ignoreChs && ignoreChs->e)
+    {
+        result = StringList_From_CountMax(1);
+        
+        int64_t cursorIndex = 0;
+        int64_t dataCounter = 0;
+        
+        while(cursorIndex <= string->count)
+        {
+            int64_t startCellIndex = cursorIndex;
+            int64_t endCellIndex = -1;
+            int32_t isEmptyCell = 0;
+            int32_t isInIgnorableRegion = 0;
+            int64_t ignoreCharCounter = 0;
+            
+            
+            for (int64_t i = 0; i < ignoreChs->count; i++)
+            {
+                if (string->e[cursorIndex] == ignoreChs->e[i])
+                {
+                    isInIgnorableRegion = 1;
+                    ignoreCharCounter++;
+                    cursorIndex++;
+                }
+            }
+            
+            // TODO(s0lly): Need to think through how to handle all ignorables
+            while(cursorIndex <= string->count && endCellIndex == -1 && !isEmptyCell)
+            {
+                uint8_t *currentChar = &string->e[cursorIndex]; 
+                
+                for (int64_t i = 0; i < delimiters->count; i++)
+                {
+                    if ((*currentChar == delimiters->e[i]) && ignoreCharCounter == 0)
+                    {
+                        if (cursorIndex == startCellIndex)
+                        {
+                            isEmptyCell = 1;
+                        }
+                        endCellIndex = cursorIndex - 1;
+                    }
+                }
+                
+                for (int64_t i = 0; i < ignoreChs->count; i++)
+                {
+                    if (*currentChar == ignoreChs->e[i])
+                    {
+                        ignoreCharCounter = 1 - ignoreCharCounter;
+                    }
+                }
+                
+                cursorIndex++;
+            }
+            
+            if (endCellIndex == -1 && !isEmptyCell)
+            {
+                endCellIndex = string->countMax - 1;
+            }
+            
+            if (cursorIndex > (int64_t)strlen((const char *)string->e) && endCellIndex == -1)
+            {
+                String tempString = String_From_CStr("").string;
+                StringList_PushCopy(&result, &tempString);
+                String_Destroy(&tempString);
+                break;
+            }
+            
+            if (endCellIndex != -1 && !isEmptyCell)
+            {
+                if (isInIgnorableRegion)
+                {
+                    startCellIndex ++;
+                    endCellIndex--;
+                }
+                
+                int64_t destIndex = 0;
+                int64_t srcIndex = startCellIndex;
+                
+                ignoreCharCounter = 0;
+                
+                uint8_t *segment = (uint8_t *)Mem_Alloc(endCellIndex - startCellIndex + 2, sizeof(uint8_t));
+                
+                while(srcIndex <= endCellIndex)
+                {
+                    if (string->e[srcIndex] == '\"')
+                    {
+                        if (ignoreCharCounter == 0)
+                        {
+                            ignoreCharCounter++;
+                        }
+                        else
+                        {
+                            segment[destIndex] = '\"';
+                            destIndex++;
+                            ignoreCharCounter = 0;
+                        }
+                    }
+                    else
+                    {
+                        segment[destIndex] = string->e[srcIndex];
+                        destIndex++;
+                    }
+                    
+                    srcIndex++;
+                    
+                }
+                
+                String tempString = String_From_CStr((const char *)segment).string;
+                StringList_PushCopy(&result, &tempString);
+                String_Destroy(&tempString);
+                Mem_Free(segment);
+                
+                startCellIndex = cursorIndex;
+            }
+            else
+            {
+                String tempString = String_From_CStr("").string;
+                StringList_PushCopy(&result, &tempString);
+                String_Destroy(&tempString);
+                
+                startCellIndex = cursorIndex;
+            }
+            
+            dataCounter++;
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringList StringList_From_File(File *file)
+{
+    StringList result = { 0 };
+    
+    if (file && file->handle)
+    {
+        String fileStr = String_From_FileNextLine(file).string;
+        
+        while(fileStr.e)
+        {
+            StringList_PushCopy(&result, &fileStr);
+            String_Reinit_FileNextLine(&fileStr, file);
+        }
+        String_Destroy(&fileStr);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringList StringList_From_Filename_String(String *filename)
+{
+    StringList result = { 0 };
+    
+    if (filename && filename->e)
+    {
+        File file = { 0 };
+        file.handle = fopen((const char *)filename->e, "rb");
+        if (file.handle)
+        {
+            result = StringList_From_File(&file);
+        }
+        
+        fclose(file.handle);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringList StringList_From_Filename_CStr(const char *cStr)
+{
+    StringList result = { 0 };
+    
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = StringList_From_Filename_String(&filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): StringListFlat functions
+
+static void StringListFlat_Destroy(StringListFlat *flatList)
+{
+    if (flatList)
+    {
+        String_Destroy(&flatList->pool);
+        Mem_Free(flatList->entries);
+        Mem_ClearBytes(flatList, sizeof(*flatList));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static StringListFlat StringListFlat_From_CountMax(int64_t countMax, int64_t poolCountMax)
+{
+    StringListFlat result = { 0 };
+    if (countMax > 0 && poolCountMax >= 0)
+    {
+        result.pool = String_From_CountMax(poolCountMax).string;
+        result.entries = (StringListFlatEntry *)Mem_Alloc(countMax, sizeof(StringListFlatEntry));
+        result.countMax = countMax;
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Returns a view into the pool - it must not be destroyed, resized or kept past the next push
+static String StringListFlat_Get(StringListFlat *flatList, int64_t index)
+{
+    String result = { 0 };
+    if (flatList && flatList->entries && index >= 0 && index < flatList->count)
+    {
+        StringListFlatEntry *entry = &flatList->entries[index];
+        result.e = flatList->pool.e + entry->offset;
+        result.count = entry->count;
+        result.countMax = entry->count;
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static void StringListFlat_Reserve(StringListFlat *flatList, int64_t countMaxNew, int64_t poolCountMaxNew)
+{
+    if (flatList)
+    {
+        if (countMaxNew > flatList->countMax)
+        {
+            StringListFlatEntry *entriesNew = (StringListFlatEntry *)Mem_Alloc(countMaxNew, sizeof(StringListFlatEntry));
+            if (flatList->entries)
+            {
+                SCL_STRING_STATS_REALLOC(flatList->count * sizeof(StringListFlatEntry));
+                memcpy(entriesNew, flatList->entries, flatList->count * sizeof(StringListFlatEntry));
+                Mem_Free(flatList->entries);
+            }
+            flatList->entries = entriesNew;
+            flatList->countMax = countMaxNew;
+        }
+        
+        if (poolCountMaxNew > flatList->pool.countMax || !flatList->pool.e)
+        {
+            String_Resize(&flatList->pool, poolCountMaxNew);
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static void StringListFlat_Push_Generic(StringListFlat *flatList, uint8_t *data, int64_t count)
+{
+    if (flatList && count >= 0 && (data || count == 0))
+    {
+        int64_t countMaxNew = flatList->countMax;
+        if (flatList->count >= countMaxNew)
+        {
+            countMaxNew = max(1, countMaxNew * 2);
+        }
+        
+        int64_t poolCountMaxNew = flatList->pool.countMax;
+        int64_t poolCountNeeded = flatList->pool.count + count + 1;
+        if (poolCountNeeded > poolCountMaxNew)
+        {
+            poolCountMaxNew = max(poolCountNeeded, poolCountMaxNew * 2);
+        }
+        
+        StringListFlat_Reserve(flatList, countMaxNew, poolCountMaxNew);
+        
+        StringListFlatEntry *entry = &flatList->entries[flatList->count];
+        entry->offset = flatList->pool.count;
+        entry->count = count;
+        memcpy(flatList->pool.e + entry->offset, data, count);
+        flatList->pool.e[entry->offset + count] = '\0';
+        flatList->pool.count += count + 1;
+        flatList->count++;
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static void StringListFlat_PushCopy(StringListFlat *flatList, String *string)
+{
+    if (flatList && string && string->e)
+    {
+        StringListFlat_Push_Generic(flatList, string->e, string->count);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static StringListFlat StringListFlat_From_StringList(StringList *stringList)
+{
+    StringListFlat result = { 0 };
+    if (stringList && stringList->e && stringList->count > 0)
+    {
+        int64_t poolCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            poolCount += StringList_Get(stringList, stringIndex)->count + 1;
+        }
+        
+        result = StringListFlat_From_CountMax(stringList->count, poolCount);
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            String *currentString = StringList_Get(stringList, stringIndex);
+            StringListFlat_Push_Generic(&result, currentString->e, currentString->e ? currentString->count : 0);
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringList StringList_From_StringListFlat(StringListFlat *flatList)
+{
+    StringList result = { 0 };
+    if (flatList && flatList->entries && flatList->count > 0)
+    {
+        result = StringList_From_CountMax(flatList->count);
+        for (int64_t stringIndex = 0; stringIndex < flatList->count; stringIndex++)
+        {
+            StringListFlatEntry *entry = &flatList->entries[stringIndex];
+            result.e[stringIndex] = String_Internal_CopyStringIntoMessage(flatList->pool.e + entry->offset,
+                                                                          entry->count, entry->count).string;
+        }
+        result.count = flatList->count;
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Reads the rest of the file in one go and splits it in place - two allocations in total
+static StringListFlat StringListFlat_From_File(File *file)
+{
+    StringListFlat result = { 0 };
+    
+    if (file && file->handle && fseek(file->handle, 0, SEEK_END) == 0)
+    {
+        int64_t fileEnd = (int64_t)ftell(file->handle);
+        int64_t byteCount = fileEnd - file->cursor;
+        if (byteCount > 0 && fseek(file->handle, file->cursor, SEEK_SET) == 0)
+        {
+            result.pool = String_From_CountMax(byteCount + 1).string;
+            byteCount = (int64_t)fread(result.pool.e, 1, byteCount, file->handle);
+            
+            int64_t lineCount = 0;
+            uint8_t *scan = result.pool.e;
+            uint8_t *scanEnd = result.pool.e + byteCount;
+            while (scan < scanEnd && (scan = (uint8_t *)memchr(scan, '\n', scanEnd - scan)) != 0)
+            {
+                lineCount++;
+                scan++;
+            }
+            int32_t hasPartialLine = (byteCount > 0 && result.pool.e[byteCount - 1] != '\n');
+            lineCount += hasPartialLine;
+            
+            if (lineCount > 0)
+            {
+                result.entries = (StringListFlatEntry *)Mem_Alloc(lineCount, sizeof(StringListFlatEntry));
+                result.countMax = lineCount;
+                
+                int64_t lineStart = 0;
+                while (result.count < lineCount)
+                {
+                    uint8_t *lineEnd = (uint8_t *)memchr(result.pool.e + lineStart, '\n', byteCount - lineStart);
+                    int64_t lineEndIndex = lineEnd ? (int64_t)(lineEnd - result.pool.e) : byteCount;
+                    result.pool.e[lineEndIndex] = '\0';
+                    result.entries[result.count].offset = lineStart;
+                    result.entries[result.count].count = lineEndIndex - lineStart;
+                    result.count++;
+                    lineStart = lineEndIndex + 1;
+                }
+            }
+            result.pool.count = byteCount + hasPartialLine;
+            file->cursor += (int32_t)byteCount;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringListFlat StringListFlat_From_Filename_String(String *filename)
+{
+    StringListFlat result = { 0 };
+    
+    if (filename && filename->e)
+    {
+        File file = { 0 };
+        file.handle = fopen((const char *)filename->e, "rb");
+        if (file.handle)
+        {
+            result = StringListFlat_From_File(&file);
+            fclose(file.handle);
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringListFlat StringListFlat_From_Filename_CStr(const char *cStr)
+{
+    StringListFlat result = { 0 };
+    
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = StringListFlat_From_Filename_String(&filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): StringThreadPool functions
+
+static void StringThreadPool_Internal_RunChunks(StringThreadPool *pool, int32_t workerIndex)
+{
+    int64_t indexStart = Platform_Atomic_AddInt64(&pool->indexNext, pool->chunkCount);
+    while (indexStart < pool->count)
+    {
+        pool->function(pool->context, indexStart, min(indexStart + pool->chunkCount, pool->count), workerIndex);
+        indexStart = Platform_Atomic_AddInt64(&pool->indexNext, pool->chunkCount);
+    }
+}
+
+static void StringThreadPool_Internal_WorkerMain(void *arg)
+{
+    StringThreadPoolWorker *worker = (StringThreadPoolWorker *)arg;
+    StringThreadPool *pool = worker->pool;
+    int64_t generationSeen = 0;
+    
+    for (;;)
+    {
+        Platform_Mutex_Lock(&pool->mutex);
+        while (pool->generation == generationSeen && !pool->shutdown)
+        {
+            Platform_CondVar_Wait(&pool->wakeCondVar, &pool->mutex);
+        }
+        int32_t shutdown = pool->shutdown;
+        generationSeen = pool->generation;
+        Platform_Mutex_Unlock(&pool->mutex);
+        
+        if (shutdown)
+        {
+            break;
+        }
+        
+        StringThreadPool_Internal_RunChunks(pool, worker->index);
+        
+        Platform_Mutex_Lock(&pool->mutex);
+        pool->workersPending--;
+        if (pool->workersPending == 0)
+        {
+            Platform_CondVar_Broadcast(&pool->doneCondVar);
+        }
+        Platform_Mutex_Unlock(&pool->mutex);
+    }
+}
+
+// NOTE(s0lly): threadCount <= 0 uses one thread per cpu. The calling thread also works during a run, so
+// threadCount - 1 background threads are started and worker indices range over [0, threadCount).
+static StringThreadPool *StringThreadPool_Create(int32_t threadCount)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = Platform_CpuCount();
+    }
+    
+    StringThreadPool *pool = (StringThreadPool *)Mem_Alloc(1, sizeof(StringThreadPool));
+    Platform_Mutex_Init(&pool->mutex);
+    Platform_CondVar_Init(&pool->wakeCondVar);
+    Platform_CondVar_Init(&pool->doneCondVar);
+    
+    pool->workers = (StringThreadPoolWorker *)Mem_Alloc(threadCount, sizeof(StringThreadPoolWorker));
+    for (int32_t workerIndex = 1; workerIndex < threadCount; workerIndex++)
+    {
+        StringThreadPoolWorker *worker = &pool->workers[pool->workerCount + 1];
+        worker->pool = pool;
+        worker->index = pool->workerCount + 1;
+        if (!Platform_Thread_Create(&worker->thread, StringThreadPool_Internal_WorkerMain, worker))
+        {
+            break;
+        }
+        pool->workerCount++;
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return pool;
+}
+
+static void StringThreadPool_Destroy(StringThreadPool *pool)
+{
+    if (pool)
+    {
+        Platform_Mutex_Lock(&pool->mutex);
+        pool->shutdown = 1;
+        Platform_CondVar_Broadcast(&pool->wakeCondVar);
+        Platform_Mutex_Unlock(&pool->mutex);
+        
+        for (int32_t workerIndex = 1; workerIndex <= pool->workerCount; workerIndex++)
+        {
+            Platform_Thread_Join(&pool->workers[workerIndex].thread);
+        }
+        
+        Platform_CondVar_Destroy(&pool->doneCondVar);
+        Platform_CondVar_Destroy(&pool->wakeCondVar);
+        Platform_Mutex_Destroy(&pool->mutex);
+        Mem_Free(pool->workers);
+        Mem_Free(pool);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static int32_t StringThreadPool_Get_ThreadCount(StringThreadPool *pool)
+{
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return pool ? pool->workerCount + 1 : 1;
+}
+
+// NOTE(s0lly): Splits [0, count) into ranges of chunkCount indices that the workers claim one at a time, and
+// returns once all of them are done. chunkCount <= 0 picks a size giving each worker several ranges to balance
+// uneven work. A null pool runs everything on the calling thread.
+// A pool does one run at a time. A Run that finds the pool busy - called from another thread meanwhile, or from a
+// callback of the current run (including through a pooled function such as StringList_ParallelMap) - runs
+// everything on its calling thread as worker 0 instead of waiting on the pool.
+static void StringThreadPool_Run(StringThreadPool *pool, int64_t count, int64_t chunkCount,
+                                 StringThreadPoolFunction function, void *context)
+{
+    if (function && count > 0)
+    {
+        int32_t isPooled = 0;
+        if (pool && pool->workerCount > 0)
+        {
+            if (chunkCount <= 0)
+            {
+                chunkCount = max(count / ((int64_t)(pool->workerCount + 1) * 8), 64);
+            }
+            
+            Platform_Mutex_Lock(&pool->mutex);
+            if (!pool->isRunning)
+            {
+                isPooled = 1;
+                pool->isRunning = 1;
+                pool->function = function;
+                pool->context = context;
+                pool->count = count;
+                pool->chunkCount = chunkCount;
+                pool->indexNext = 0;
+                pool->workersPending = pool->workerCount;
+                pool->generation++;
+                Platform_CondVar_Broadcast(&pool->wakeCondVar);
+            }
+            Platform_Mutex_Unlock(&pool->mutex);
+        }
+        
+        if (isPooled)
+        {
+            StringThreadPool_Internal_RunChunks(pool, 0);
+            
+            Platform_Mutex_Lock(&pool->mutex);
+            while (pool->workersPending > 0)
+            {
+                Platform_CondVar_Wait(&pool->doneCondVar, &pool->mutex);
+            }
+            pool->isRunning = 0;
+            Platform_Mutex_Unlock(&pool->mutex);
+        }
+        else
+        {
+            function(context, 0, count, 0);
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+
+// NOTE(s0lly): Parallel StringList functions
+
+typedef struct StringList_Internal_ParallelContext
+{
+    StringList *src;
+    StringList *dst;
+    int64_t *positions;
+    void (*forEachFunction)(String *string, void *context);
+    StringMessage (*mapFunction)(String *string, void *context);
+    int32_t (*filterFunction)(String *string, void *context);
+    void *context;
+    
+} StringList_Internal_ParallelContext;
+
+static void StringList_Internal_ParallelForEachRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    StringList_Internal_ParallelContext *parallel = (StringList_Internal_ParallelContext *)context;
+    (void)workerIndex;
+    for (int64_t stringIndex = indexStart; stringIndex < indexEnd; stringIndex++)
+    {
+        parallel->forEachFunction(&parallel->src->e[stringIndex], parallel->context);
+    }
+}
+
+static void StringList_Internal_ParallelMapRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    StringList_Internal_ParallelContext *parallel = (StringList_Internal_ParallelContext *)context;
+    (void)workerIndex;
+    for (int64_t stringIndex = indexStart; stringIndex < indexEnd; stringIndex++)
+    {
+        StringMessage msg = parallel->mapFunction(&parallel->src->e[stringIndex], parallel->context);
+        parallel->dst->e[stringIndex] = (msg.code == SCL_STRING_CODE__NO_MESSAGE) ? msg.string : String_From_CStr("").string;
+    }
+}
+
+static void StringList_Internal_ParallelFilterRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    StringList_Internal_ParallelContext *parallel = (StringList_Internal_ParallelContext *)context;
+    (void)workerIndex;
+    for (int64_t stringIndex = indexStart; stringIndex < indexEnd; stringIndex++)
+    {
+        parallel->positions[stringIndex] = parallel->filterFunction(&parallel->src->e[stringIndex], parallel->context) ? 1 : 0;
+    }
+}
+
+static void StringList_Internal_ParallelCopyRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    StringList_Internal_ParallelContext *parallel = (StringList_Internal_ParallelContext *)context;
+    (void)workerIndex;
+    for (int64_t stringIndex = indexStart; stringIndex < indexEnd; stringIndex++)
+    {
+        if (parallel->positions[stringIndex] >= 0)
+        {
+            parallel->dst->e[parallel->positions[stringIndex]] = String_From_String(&parallel->src->e[stringIndex]).string;
+        }
+    }
+}
+
+// NOTE(s0lly): Calls function on every element in place, e.g. String_Remove_WhitespaceSurrounding
+static void StringList_ParallelForEach(StringThreadPool *pool, StringList *stringList,
+                                       void (*function)(String *string, void *context), void *context)
+{
+    if (stringList && stringList->e && function)
+    {
+        StringList_Internal_ParallelContext parallel = { 0 };
+        parallel.src = stringList;
+        parallel.forEachFunction = function;
+        parallel.context = context;
+        StringThreadPool_Run(pool, stringList->count, 0, StringList_Internal_ParallelForEachRange, &parallel);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Builds a new list where element i is the string returned by function for element i. Elements for
+// which function returns an error code become empty strings.
+static StringList StringList_ParallelMap(StringThreadPool *pool, StringList *stringList,
+                                         StringMessage (*function)(String *string, void *context), void *context)
+{
+    StringList result = { 0 };
+    if (stringList && stringList->e && stringList->count > 0 && function)
+    {
+        result = StringList_From_CountMax(stringList->count);
+        result.count = stringList->count;
+        
+        StringList_Internal_ParallelContext parallel = { 0 };
+        parallel.src = stringList;
+        parallel.dst = &result;
+        parallel.mapFunction = function;
+        parallel.context = context;
+        StringThreadPool_Run(pool, stringList->count, 0, StringList_Internal_ParallelMapRange, &parallel);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Builds a new list holding copies of the elements for which function returns non-zero, in their
+// original order
+static StringList StringList_ParallelFilter(StringThreadPool *pool, StringList *stringList,
+                                            int32_t (*function)(String *string, void *context), void *context)
+{
+    StringList result = { 0 };
+    if (stringList && stringList->e && stringList->count > 0 && function)
+    {
+        StringList_Internal_ParallelContext parallel = { 0 };
+        parallel.src = stringList;
+        parallel.dst = &result;
+        parallel.filterFunction = function;
+        parallel.context = context;
+        parallel.positions = (int64_t *)Mem_Alloc(stringList->count, sizeof(int64_t));
+        StringThreadPool_Run(pool, stringList->count, 0, StringList_Internal_ParallelFilterRange, &parallel);
+        
+        int64_t keptCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            parallel.positions[stringIndex] = parallel.positions[stringIndex] ? keptCount++ : -1;
+        }
+        
+        if (keptCount > 0)
+        {
+            result = StringList_From_CountMax(keptCount);
+            result.count = keptCount;
+            StringThreadPool_Run(pool, stringList->count, 0, StringList_Internal_ParallelCopyRange, &parallel);
+        }
+        Mem_Free(parallel.positions);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+
+// NOTE(s0lly): StringPattern functions
+
+#define SCL_STRING_PATTERN_STATE_COUNT_MAX 4096
+#define SCL_STRING_PATTERN_DEPTH_MAX 256
+
+#define SCL_STRING_PATTERN_STATE_FLAG__BEGIN 0x1
+#define SCL_STRING_PATTERN_STATE_FLAG__ACCEPT 0x2
+#define SCL_STRING_PATTERN_STATE_FLAG__ACCEPT_AT_END 0x4
+#define SCL_STRING_PATTERN_STATE_FLAG__DEAD 0x8
+
+typedef struct StringPattern_Internal_Fragment
+{
+    int32_t start;
+    int32_t end;
+    
+} StringPattern_Internal_Fragment;
+
+typedef struct StringPattern_Internal_Parser
+{
+    const uint8_t *data;
+    int64_t count;
+    int64_t index;
+    int32_t depth;
+    int32_t error;
+    
+    StringPatternNode *nodes;
+    int32_t nodeCount;
+    int32_t nodeCountMax;
+    
+    // NOTE(s0lly): Runs of plain literals in the top level concatenation - the longest becomes the prefilter
+    int32_t atomLiteral;
+    int32_t literalInvalid;
+    uint8_t *literalRun;
+    int64_t literalRunCount;
+    uint8_t *literalBest;
+    int64_t literalBestCount;
+    
+} StringPattern_Internal_Parser;
+
+static int32_t StringPattern_Internal_SetHas(const uint8_t *set, uint8_t ch)
+{
+    return (set[ch >> 3] >> (ch & 7)) & 1;
+}
+
+static void StringPattern_Internal_SetAdd(uint8_t *set, uint8_t ch)
+{
+    set[ch >> 3] |= (uint8_t)(1 << (ch & 7));
+}
+
+static void StringPattern_Internal_SetAddRange(uint8_t *set, uint8_t chLow, uint8_t chHigh)
+{
+    for (int32_t ch = chLow; ch <= chHigh; ch++)
+    {
+        StringPattern_Internal_SetAdd(set, (uint8_t)ch);
+    }
+}
+
+// NOTE(s0lly): Handles \d \w \s and their negations, returns 0 for any other escape
+static int32_t StringPattern_Internal_SetAddShorthand(uint8_t *set, uint8_t escape)
+{
+    uint8_t shorthand[32] = { 0 };
+    switch (escape | 0x20)
+    {
+        case 'd':
+        {
+            StringPattern_Internal_SetAddRange(shorthand, '0', '9');
+        } break;
+        case 'w':
+        {
+            StringPattern_Internal_SetAddRange(shorthand, '0', '9');
+            StringPattern_Internal_SetAddRange(shorthand, 'a', 'z');
+            StringPattern_Internal_SetAddRange(shorthand, 'A', 'Z');
+            StringPattern_Internal_SetAdd(shorthand, '_');
+        } break;
+        case 's':
+        {
+            StringPattern_Internal_SetAddRange(shorthand, '\t', '\r');
+            StringPattern_Internal_SetAdd(shorthand, ' ');
+        } break;
+        default:
+        {
+            return 0;
+        }
+    }
+    
+    int32_t negate = (escape >= 'A' && escape <= 'Z');
+    for (int32_t byteIndex = 0; byteIndex < 32; byteIndex++)
+    {
+        set[byteIndex] |= negate ? (uint8_t)~shorthand[byteIndex] : shorthand[byteIndex];
+    }
+    return 1;
+}
+
+static uint8_t StringPattern_Internal_EscapedByte(uint8_t escape)
+{
+    uint8_t result = escape;
+    if (escape == 'n')
+    {
+        result = '\n';
+    }
+    else if (escape == 't')
+    {
+        result = '\t';
+    }
+    else if (escape == 'r')
+    {
+        result = '\r';
+    }
+    return result;
+}
+
+static int32_t StringPattern_Internal_AddNode(StringPattern_Internal_Parser *parser, SCL_STRING_PATTERN_NODE type,
+                                             int32_t out, int32_t outAlt)
+{
+    if (parser->nodeCount >= parser->nodeCountMax)
+    {
+        int32_t nodeCountMaxNew = max(parser->nodeCountMax * 2, 16);
+        StringPatternNode *nodesNew = (StringPatternNode *)Mem_Alloc(nodeCountMaxNew, sizeof(StringPatternNode));
+        if (parser->nodes)
+        {
+            memcpy(nodesNew, parser->nodes, parser->nodeCount * sizeof(StringPatternNode));
+            Mem_Free(parser->nodes);
+        }
+        parser->nodes = nodesNew;
+        parser->nodeCountMax = nodeCountMaxNew;
+    }
+    
+    StringPatternNode *node = &parser->nodes[parser->nodeCount];
+    node->type = type;
+    node->out = out;
+    node->outAlt = outAlt;
+    return parser->nodeCount++;
+}
+
+// NOTE(s0lly): A fragment is a node followed by an empty link node whose out is patched when concatenating
+static StringPattern_Internal_Fragment StringPattern_Internal_Fragment_From_Node(StringPattern_Internal_Parser *parser,
+                                                                                 SCL_STRING_PATTERN_NODE type)
+{
+    StringPattern_Internal_Fragment result = { 0 };
+    result.end = StringPattern_Internal_AddNode(parser, SCL_STRING_PATTERN_NODE__SPLIT, -1, -1);
+    result.start = StringPattern_Internal_AddNode(parser, type, result.end, -1);
+    return result;
+}
+
+static StringPattern_Internal_Fragment StringPattern_Internal_ParseAlternation(StringPattern_Internal_Parser *parser);
+
+static StringPattern_Internal_Fragment StringPattern_Internal_ParseClass(StringPattern_Internal_Parser *parser)
+{
+    uint8_t set[32] = { 0 };
+    int32_t negate = 0;
+    int32_t first = 1;
+    
+    parser->index++;
+    if (parser->index < parser->count && parser->data[parser->index] == '^')
+    {
+        negate = 1;
+        parser->index++;
+    }
+    
+    while (!parser->error && parser->index < parser->count && (parser->data[parser->index] != ']' || first))
+    {
+        first = 0;
+        uint8_t chLow = parser->data[parser->index++];
+        if (chLow == '\\')
+        {
+            if (parser->index >= parser->count)
+            {
+                parser->error = 1;
+                break;
+            }
+            uint8_t escape = parser->data[parser->index++];
+            if (StringPattern_Internal_SetAddShorthand(set, escape))
+            {
+                continue;
+            }
+            chLow = StringPattern_Internal_EscapedByte(escape);
+        }
+        
+        if (parser->index + 1 < parser->count && parser->data[parser->index] == '-' && parser->data[parser->index + 1] != ']')
+        {
+            parser->index++;
+            uint8_t chHigh = parser->data[parser->index++];
+            if (chHigh == '\\')
+            {
+                if (parser->index >= parser->count)
+                {
+                    parser->error = 1;
+                    break;
+                }
+                chHigh = StringPattern_Internal_EscapedByte(parser->data[parser->index++]);
+            }
+            if (chHigh < chLow)
+            {
+                parser->error = 1;
+                break;
+            }
+            StringPattern_Internal_SetAddRange(set, chLow, chHigh);
+        }
+        else
+        {
+            StringPattern_Internal_SetAdd(set, chLow);
+        }
+    }
+    
+    StringPattern_Internal_Fragment result = { -1, -1 };
+    if (!parser->error && parser->index < parser->count)
+    {
+        parser->index++;
+        if (negate)
+        {
+            for (int32_t byteIndex = 0; byteIndex < 32; byteIndex++)
+            {
+                set[byteIndex] = (uint8_t)~set[byteIndex];
+            }
+        }
+        result = StringPattern_Internal_Fragment_From_Node(parser, SCL_STRING_PATTERN_NODE__CHAR);
+        memcpy(parser->nodes[result.start].set, set, sizeof(set));
+    }
+    else
+    {
+        parser->error = 1;
+    }
+    return result;
+}
+
+static StringPattern_Internal_Fragment StringPattern_Internal_ParseAtom(StringPattern_Internal_Parser *parser)
+{
+    StringPattern_Internal_Fragment result = { -1, -1 };
+    uint8_t ch = parser->data[parser->index];
+    parser->atomLiteral = -1;
+    
+    if (ch == '(')
+    {
+        parser->index++;
+        parser->depth++;
+        if (parser->depth > SCL_STRING_PATTERN_DEPTH_MAX)
+        {
+            parser->error = 1;
+        }
+        else
+        {
+            result = StringPattern_Internal_ParseAlternation(parser);
+            if (!parser->error && parser->index < parser->count && parser->data[parser->index] == ')')
+            {
+                parser->index++;
+            }
+            else
+            {
+                parser->error = 1;
+            }
+        }
+        parser->depth--;
+        parser->atomLiteral = -1;
+    }
+    else if (ch == '[')
+    {
+        result = StringPattern_Internal_ParseClass(parser);
+    }
+    else if (ch == '.')
+    {
+        parser->index++;
+        result = StringPattern_Internal_Fragment_From_Node(parser, SCL_STRING_PATTERN_NODE__CHAR);
+        memset(parser->nodes[result.start].set, 0xFF, 32);
+    }
+    else if (ch == '^')
+    {
+        parser->index++;
+        result = StringPattern_Internal_Fragment_From_Node(parser, SCL_STRING_PATTERN_NODE__ASSERT_BEGIN);
+    }
+    else if (ch == '$')
+    {
+        parser->index++;
+        result = StringPattern_Internal_Fragment_From_Node(parser, SCL_STRING_PATTERN_NODE__ASSERT_END);
+    }
+    else if (ch == '*' || ch == '+' || ch == '?' || ch == ')' || ch == '|')
+    {
+        parser->error = 1;
+    }
+    else
+    {
+        parser->index++;
+        result = StringPattern_Internal_Fragment_From_Node(parser, SCL_STRING_PATTERN_NODE__CHAR);
+        if (ch == '\\')
+        {
+            if (parser->index >= parser->count)
+            {
+                parser->error = 1;
+                return result;
+            }
+            uint8_t escape = parser->data[parser->index++];
+            if (StringPattern_Internal_SetAddShorthand(parser->nodes[result.start].set, escape))
+            {
+                return result;
+            }
+            ch = StringPattern_Internal_EscapedByte(escape);
+        }
+        StringPattern_Internal_SetAdd(parser->nodes[result.start].set, ch);
+        parser->atomLiteral = ch;
+    }
+    return result;
+}
+
+static StringPattern_Internal_Fragment StringPattern_Internal_ParseRepeat(StringPattern_Internal_Parser *parser)
+{
+    StringPattern_Internal_Fragment result = StringPattern_Internal_ParseAtom(parser);
+    while (!parser->error && parser->index < parser->count)
+    {
+        uint8_t ch = parser->data[parser->index];
+        if (ch != '*' && ch != '+' && ch != '?')
+        {
+            break;
+        }
+        parser->index++;
+        parser->atomLiteral = -1;
+        
+        int32_t end = StringPattern_Internal_AddNode(parser, SCL_STRING_PATTERN_NODE__SPLIT, -1, -1);
+        int32_t split = StringPattern_Internal_AddNode(parser, SCL_STRING_PATTERN_NODE__SPLIT, result.start, end);
+        if (ch == '*')
+        {
+            parser->nodes[result.end].out = split;
+            result.start = split;
+        }
+        else if (ch == '+')
+        {
+            parser->nodes[result.end].out = split;
+        }
+        else
+        {
+            parser->nodes[result.end].out = end;
+            result.start = split;
+        }
+        result.end = end;
+    }
+    return result;
+}
+
+static void StringPattern_Internal_EndLiteralRun(StringPattern_Internal_Parser *parser)
+{
+    if (parser->literalRunCount > parser->literalBestCount)
+    {
+        memcpy(parser->literalBest, parser->literalRun, parser->literalRunCount);
+        parser->literalBestCount = parser->literalRunCount;
+    }
+    parser->literalRunCount = 0;
+}
+
+static StringPattern_Internal_Fragment StringPattern_Internal_ParseConcatenation(StringPattern_Internal_Parser *parser)
+{
+    StringPattern_Internal_Fragment result = { -1, -1 };
+    result.start = StringPattern_Internal_AddNode(parser, SCL_STRING_PATTERN_NODE__SPLIT, -1, -1);
+    result.end = result.start;
+    
+    while (!parser->error && parser->index < parser->count
+           && parser->data[parser->index] != '|' && parser->data[parser->index] != ')')
+    {
+        StringPattern_Internal_Fragment next = StringPattern_Internal_ParseRepeat(parser);
+        if (parser->error)
+        {
+            break;
+        }
+        parser->nodes[result.end].out = next.start;
+        result.end = next.end;
+        
+        if (parser->depth == 0)
+        {
+            if (parser->atomLiteral >= 0)
+            {
+                parser->literalRun[parser->literalRunCount++] = (uint8_t)parser->atomLiteral;
+            }
+            else
+            {
+                StringPattern_Internal_EndLiteralRun(parser);
+            }
+        }
+    }
+    
+    if (parser->depth == 0)
+    {
+        StringPattern_Internal_EndLiteralRun(parser);
+    }
+    return result;
+}
+
+static StringPattern_Internal_Fragment StringPattern_Internal_ParseAlternation(StringPattern_Internal_Parser *parser)
+{
+    StringPattern_Internal_Fragment result = StringPattern_Internal_ParseConcatenation(parser);
+    while (!parser->error && parser->index < parser->count && parser->data[parser->index] == '|')
+    {
+        parser->index++;
+        if (parser->depth == 0)
+        {
+            // NOTE(s0lly): A top level literal is no longer required by every match
+            parser->literalInvalid = 1;
+        }
+        
+        StringPattern_Internal_Fragment other = StringPattern_Internal_ParseConcatenation(parser);
+        if (parser->error)
+        {
+            break;
+        }
+        int32_t end = StringPattern_Internal_AddNode(parser, SCL_STRING_PATTERN_NODE__SPLIT, -1, -1);
+        int32_t split = StringPattern_Internal_AddNode(parser, SCL_STRING_PATTERN_NODE__SPLIT, result.start, other.start);
+        parser->nodes[result.end].out = end;
+        parser->nodes[other.end].out = end;
+        result.start = split;
+        result.end = end;
+    }
+    return result;
+}
+
+// NOTE(s0lly): Rewrites a glob as an anchored regex - * becomes .*, ? becomes ., [!...] becomes [^...] and
+// regex operators are escaped. Returns the written count, the buffer needs room for count * 2 + 2 bytes.
+static int64_t StringPattern_Internal_GlobToRegex(const uint8_t *data, int64_t count, uint8_t *regex)
+{
+    int64_t regexCount = 0;
+    regex[regexCount++] = '^';
+    for (int64_t index = 0; index < count; index++)
+    {
+        uint8_t ch = data[index];
+        if (ch == '*')
+        {
+            regex[regexCount++] = '.';
+            regex[regexCount++] = '*';
+        }
+        else if (ch == '?')
+        {
+            regex[regexCount++] = '.';
+        }
+        else if (ch == '[')
+        {
+            int64_t classEnd = index + 1;
+            if (classEnd < count && (data[classEnd] == '!' || data[classEnd] == '^'))
+            {
+                classEnd++;
+            }
+            if (classEnd < count && data[classEnd] == ']')
+            {
+                classEnd++;
+            }
+            while (classEnd < count && data[classEnd] != ']')
+            {
+                classEnd++;
+            }
+            
+            if (classEnd < count)
+            {
+                regex[regexCount++] = '[';
+                index++;
+                if (data[index] == '!' || data[index] == '^')
+                {
+                    regex[regexCount++] = '^';
+                    index++;
+                }
+                for (; index < classEnd; index++)
+                {
+                    if (data[index] == '\\')
+                    {
+                        regex[regexCount++] = '\\';
+                    }
+                    regex[regexCount++] = data[index];
+                }
+                regex[regexCount++] = ']';
+            }
+            else
+            {
+                regex[regexCount++] = '\\';
+                regex[regexCount++] = '[';
+            }
+        }
+        else if (ch == '\\' && index + 1 < count)
+        {
+            index++;
+            regex[regexCount++] = '\\';
+            regex[regexCount++] = data[index];
+        }
+        else
+        {
+            if (strchr("\\.+()|^$]", ch) && ch != 0)
+            {
+                regex[regexCount++] = '\\';
+            }
+            regex[regexCount++] = ch;
+        }
+    }
+    regex[regexCount++] = '$';
+    return regexCount;
+}
+
+static void StringPattern_Destroy(StringPattern *pattern)
+{
+    if (pattern)
+    {
+        Mem_Free(pattern->nodes);
+        Mem_Free(pattern->prefilter);
+        Mem_Free(pattern->states);
+        Mem_Free(pattern->transitions);
+        Mem_Free(pattern->stateTable);
+        Mem_Free(pattern->stateNodes);
+        Mem_Free(pattern->scratchNodes);
+        Mem_Free(pattern->scratchStack);
+        Mem_Free(pattern->scratchMarks);
+        Mem_ClearBytes(pattern, sizeof(*pattern));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Drops every cached state - used once the cache reaches SCL_STRING_PATTERN_STATE_COUNT_MAX states
+static void StringPattern_Internal_FlushStates(StringPattern *pattern)
+{
+    pattern->stateCount = 0;
+    pattern->stateNodeCount = 0;
+    pattern->stateStart = -1;
+    memset(pattern->stateTable, 0xFF, pattern->stateTableCount * sizeof(int32_t));
+}
+
+static void StringPattern_Internal_GrowStates(StringPattern *pattern, int32_t stateCountMaxNew)
+{
+    StringPatternState *statesNew = (StringPatternState *)Mem_Alloc(stateCountMaxNew, sizeof(StringPatternState));
+    int32_t *transitionsNew = (int32_t *)Mem_Alloc((int64_t)stateCountMaxNew * pattern->classCount, sizeof(int32_t));
+    int32_t stateTableCountNew = stateCountMaxNew * 2;
+    int32_t *stateTableNew = (int32_t *)Mem_Alloc(stateTableCountNew, sizeof(int32_t));
+    memset(stateTableNew, 0xFF, stateTableCountNew * sizeof(int32_t));
+    
+    if (pattern->states)
+    {
+        SCL_STRING_STATS_REALLOC(pattern->stateCount * (sizeof(StringPatternState) + pattern->classCount * sizeof(int32_t)));
+        memcpy(statesNew, pattern->states, pattern->stateCount * sizeof(StringPatternState));
+        memcpy(transitionsNew, pattern->transitions, (int64_t)pattern->stateCount * pattern->classCount * sizeof(int32_t));
+        for (int32_t stateIndex = 0; stateIndex < pattern->stateCount; stateIndex++)
+        {
+            uint32_t slot = statesNew[stateIndex].hash & (uint32_t)(stateTableCountNew - 1);
+            while (stateTableNew[slot] >= 0)
+            {
+                slot = (slot + 1) & (uint32_t)(stateTableCountNew - 1);
+            }
+            stateTableNew[slot] = stateIndex;
+        }
+        Mem_Free(pattern->states);
+        Mem_Free(pattern->transitions);
+        Mem_Free(pattern->stateTable);
+    }
+    
+    pattern->states = statesNew;
+    pattern->transitions = transitionsNew;
+    pattern->stateTable = stateTableNew;
+    pattern->stateTableCount = stateTableCountNew;
+    pattern->stateCountMax = stateCountMaxNew;
+}
+
+static void StringPattern_Internal_ScratchReset(StringPattern *pattern)
+{
+    pattern->scratchGeneration++;
+    if (pattern->scratchGeneration == 0)
+    {
+        memset(pattern->scratchMarks, 0, pattern->nodeCount * sizeof(uint32_t));
+        pattern->scratchGeneration = 1;
+    }
+}
+
+// NOTE(s0lly): Adds the nodes reachable from node without consuming a byte to the scratch set. ^ is only passed
+// through at the start of the input.
+static void StringPattern_Internal_AddClosure(StringPattern *pattern, int32_t node, int32_t atBegin)
+{
+    int32_t stackCount = 0;
+    if (node >= 0 && pattern->scratchMarks[node] != pattern->scratchGeneration)
+    {
+        pattern->scratchMarks[node] = pattern->scratchGeneration;
+        pattern->scratchStack[stackCount++] = node;
+    }
+    
+    while (stackCount > 0)
+    {
+        StringPatternNode *current = &pattern->nodes[pattern->scratchStack[--stackCount]];
+        int32_t nextNodes[2] = { -1, -1 };
+        if (current->type == SCL_STRING_PATTERN_NODE__SPLIT)
+        {
+            nextNodes[0] = current->out;
+            nextNodes[1] = current->outAlt;
+        }
+        else if (current->type == SCL_STRING_PATTERN_NODE__ASSERT_BEGIN)
+        {
+            nextNodes[0] = atBegin ? current->out : -1;
+        }
+        else
+        {
+            pattern->scratchNodes[pattern->scratchNodeCount++] = (int32_t)(current - pattern->nodes);
+        }
+        
+        for (int32_t nextIndex = 0; nextIndex < 2; nextIndex++)
+        {
+            int32_t next = nextNodes[nextIndex];
+            if (next >= 0 && pattern->scratchMarks[next] != pattern->scratchGeneration)
+            {
+                pattern->scratchMarks[next] = pattern->scratchGeneration;
+                pattern->scratchStack[stackCount++] = next;
+            }
+        }
+    }
+}
+
+// NOTE(s0lly): Whether a match is reached if the input ends here, i.e. after passing the $ nodes in the scratch set
+static int32_t StringPattern_Internal_AcceptsAtEnd(StringPattern *pattern, int32_t atBegin)
+{
+    int32_t result = 0;
+    int32_t setCount = pattern->scratchNodeCount;
+    StringPattern_Internal_ScratchReset(pattern);
+    for (int32_t setIndex = 0; setIndex < setCount && !result; setIndex++)
+    {
+        int32_t node = pattern->scratchNodes[setIndex];
+        if (pattern->nodes[node].type != SCL_STRING_PATTERN_NODE__ASSERT_END)
+        {
+            continue;
+        }
+        
+        int32_t stackCount = 0;
+        pattern->scratchStack[stackCount++] = node;
+        pattern->scratchMarks[node] = pattern->scratchGeneration;
+        while (stackCount > 0 && !result)
+        {
+            StringPatternNode *current = &pattern->nodes[pattern->scratchStack[--stackCount]];
+            int32_t nextNodes[2] = { -1, -1 };
+            if (current->type == SCL_STRING_PATTERN_NODE__MATCH)
+            {
+                result = 1;
+            }
+            else if (current->type == SCL_STRING_PATTERN_NODE__SPLIT)
+            {
+                nextNodes[0] = current->out;
+                nextNodes[1] = current->outAlt;
+            }
+            else if (current->type == SCL_STRING_PATTERN_NODE__ASSERT_END
+                     || (current->type == SCL_STRING_PATTERN_NODE__ASSERT_BEGIN && atBegin))
+            {
+                nextNodes[0] = current->out;
+            }
+            
+            for (int32_t nextIndex = 0; nextIndex < 2; nextIndex++)
+            {
+                int32_t next = nextNodes[nextIndex];
+                if (next >= 0 && pattern->scratchMarks[next] != pattern->scratchGeneration)
+                {
+                    pattern->scratchMarks[next] = pattern->scratchGeneration;
+                    pattern->scratchStack[stackCount++] = next;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+static int StringPattern_Internal_CompareNodes(const void *a, const void *b)
+{
+    int32_t nodeA = *(const int32_t *)a;
+    int32_t nodeB = *(const int32_t *)b;
+    return (nodeA > nodeB) - (nodeA < nodeB);
+}
+
+// NOTE(s0lly): Returns the cached state for the scratch set, adding it if it is new
+static int32_t StringPattern_Internal_FindOrAddState(StringPattern *pattern, int32_t atBegin)
+{
+    int32_t *set = pattern->scratchNodes;
+    int32_t setCount = pattern->scratchNodeCount;
+    qsort(set, setCount, sizeof(int32_t), StringPattern_Internal_CompareNodes);
+    
+    uint32_t hash = 2166136261u ^ (uint32_t)atBegin;
+    for (int32_t setIndex = 0; setIndex < setCount; setIndex++)
+    {
+        hash = (hash ^ (uint32_t)set[setIndex]) * 16777619u;
+    }
+    
+    uint32_t slotMask = (uint32_t)(pattern->stateTableCount - 1);
+    uint32_t slot = hash & slotMask;
+    while (pattern->stateTable[slot] >= 0)
+    {
+        StringPatternState *state = &pattern->states[pattern->stateTable[slot]];
+        if (state->hash == hash && state->nodeCount == setCount
+            && (state->flags & SCL_STRING_PATTERN_STATE_FLAG__BEGIN) == (atBegin ? SCL_STRING_PATTERN_STATE_FLAG__BEGIN : 0)
+            && memcmp(&pattern->stateNodes[state->nodeIndex], set, setCount * sizeof(int32_t)) == 0)
+        {
+            return pattern->stateTable[slot];
+        }
+        slot = (slot + 1) & slotMask;
+    }
+    
+    if (pattern->stateCount >= pattern->stateCountMax)
+    {
+        if (pattern->stateCountMax < SCL_STRING_PATTERN_STATE_COUNT_MAX)
+        {
+            StringPattern_Internal_GrowStates(pattern, pattern->stateCountMax * 2);
+        }
+        else
+        {
+            StringPattern_Internal_FlushStates(pattern);
+        }
+        slotMask = (uint32_t)(pattern->stateTableCount - 1);
+        slot = hash & slotMask;
+        while (pattern->stateTable[slot] >= 0)
+        {
+            slot = (slot + 1) & slotMask;
+        }
+    }
+    
+    if (pattern->stateNodeCount + setCount > pattern->stateNodeCountMax)
+    {
+        int64_t stateNodeCountMaxNew = max(pattern->stateNodeCountMax * 2, pattern->stateNodeCount + setCount);
+        int32_t *stateNodesNew = (int32_t *)Mem_Alloc(stateNodeCountMaxNew, sizeof(int32_t));
+        if (pattern->stateNodes)
+        {
+            SCL_STRING_STATS_REALLOC(pattern->stateNodeCount * sizeof(int32_t));
+            memcpy(stateNodesNew, pattern->stateNodes, pattern->stateNodeCount * sizeof(int32_t));
+            Mem_Free(pattern->stateNodes);
+        }
+        pattern->stateNodes = stateNodesNew;
+        pattern->stateNodeCountMax = stateNodeCountMaxNew;
+    }
+    
+    int32_t stateIndex = pattern->stateCount++;
+    StringPatternState *state = &pattern->states[stateIndex];
+    state->nodeIndex = pattern->stateNodeCount;
+    state->nodeCount = setCount;
+    state->hash = hash;
+    state->flags = atBegin ? SCL_STRING_PATTERN_STATE_FLAG__BEGIN : 0;
+    memcpy(&pattern->stateNodes[state->nodeIndex], set, setCount * sizeof(int32_t));
+    pattern->stateNodeCount += setCount;
+    pattern->stateTable[slot] = stateIndex;
+    memset(&pattern->transitions[(int64_t)stateIndex * pattern->classCount], 0xFF, pattern->classCount * sizeof(int32_t));
+    
+    if (setCount == 0)
+    {
+        state->flags |= SCL_STRING_PATTERN_STATE_FLAG__DEAD;
+    }
+    else if (pattern->nodes[set[setCount - 1]].type == SCL_STRING_PATTERN_NODE__MATCH)
+    {
+        // NOTE(s0lly): The match node is always the last node, so sorts last
+        state->flags |= SCL_STRING_PATTERN_STATE_FLAG__ACCEPT;
+    }
+    else if (StringPattern_Internal_AcceptsAtEnd(pattern, atBegin))
+    {
+        state->flags |= SCL_STRING_PATTERN_STATE_FLAG__ACCEPT_AT_END;
+    }
+    return stateIndex;
+}
+
+static int32_t StringPattern_Internal_StartState(StringPattern *pattern)
+{
+    if (pattern->stateStart < 0)
+    {
+        pattern->scratchNodeCount = 0;
+        StringPattern_Internal_ScratchReset(pattern);
+        StringPattern_Internal_AddClosure(pattern, pattern->nodeStart, 1);
+        pattern->stateStart = StringPattern_Internal_FindOrAddState(pattern, 1);
+    }
+    return pattern->stateStart;
+}
+
+// NOTE(s0lly): Computes and caches the transition out of stateIndex on a byte of classIndex. The start closure is
+// added to every state, so a match may begin at any position. Cached entries hold the target's transition row
+// offset, or -2 - target for accepting and dead targets so the matching loop only has to test for negatives.
+static int32_t StringPattern_Internal_Step(StringPattern *pattern, int32_t stateIndex, int32_t classIndex)
+{
+    uint8_t ch = pattern->classBytes[classIndex];
+    StringPatternState state = pattern->states[stateIndex];
+    
+    pattern->scratchNodeCount = 0;
+    StringPattern_Internal_ScratchReset(pattern);
+    for (int32_t setIndex = 0; setIndex < state.nodeCount; setIndex++)
+    {
+        StringPatternNode *node = &pattern->nodes[pattern->stateNodes[state.nodeIndex + setIndex]];
+        if (node->type == SCL_STRING_PATTERN_NODE__CHAR && StringPattern_Internal_SetHas(node->set, ch))
+        {
+            StringPattern_Internal_AddClosure(pattern, node->out, 0);
+        }
+    }
+    StringPattern_Internal_AddClosure(pattern, pattern->nodeStart, 0);
+    
+    int32_t stateCountBefore = pattern->stateCount;
+    int32_t result = StringPattern_Internal_FindOrAddState(pattern, 0);
+    if (pattern->stateCount >= stateCountBefore)
+    {
+        int32_t special = pattern->states[result].flags & (SCL_STRING_PATTERN_STATE_FLAG__ACCEPT | SCL_STRING_PATTERN_STATE_FLAG__DEAD);
+        pattern->transitions[(int64_t)stateIndex * pattern->classCount + classIndex] = special ? -2 - result : result * pattern->classCount;
+    }
+    return result;
+}
+
+// NOTE(s0lly): Returns the offset just past the earliest ending match, or -1 when there is none
+static int64_t StringPattern_Internal_Run(StringPattern *pattern, const uint8_t *data, int64_t count)
+{
+    int32_t stateIndex = StringPattern_Internal_StartState(pattern);
+    int32_t flags = pattern->states[stateIndex].flags;
+    if (flags & (SCL_STRING_PATTERN_STATE_FLAG__ACCEPT | SCL_STRING_PATTERN_STATE_FLAG__DEAD))
+    {
+        return (flags & SCL_STRING_PATTERN_STATE_FLAG__ACCEPT) ? 0 : -1;
+    }
+    
+    const int32_t *transitions = pattern->transitions;
+    int32_t row = stateIndex * pattern->classCount;
+    for (int64_t index = 0; index < count; index++)
+    {
+        int32_t classIndex = pattern->byteClasses[data[index]];
+        int32_t next = transitions[row + classIndex];
+        if (next < 0)
+        {
+            stateIndex = (next == -1) ? StringPattern_Internal_Step(pattern, row / pattern->classCount, classIndex) : -2 - next;
+            flags = pattern->states[stateIndex].flags;
+            if (flags & (SCL_STRING_PATTERN_STATE_FLAG__ACCEPT | SCL_STRING_PATTERN_STATE_FLAG__DEAD))
+            {
+                return (flags & SCL_STRING_PATTERN_STATE_FLAG__ACCEPT) ? index + 1 : -1;
+            }
+            transitions = pattern->transitions;
+            next = stateIndex * pattern->classCount;
+        }
+        row = next;
+    }
+    
+    flags = pattern->states[row / pattern->classCount].flags;
+    return (flags & SCL_STRING_PATTERN_STATE_FLAG__ACCEPT_AT_END) ? count : -1;
+}
+
+// NOTE(s0lly): Compiles a glob (*, ?, [...], [!...], matched against the whole string) or a regex subset (literals,
+// ., [...], [^...], \d \w \s, groups, |, *, +, ?, ^ and $, matched anywhere unless anchored). Returns a zeroed
+// pattern if the syntax is invalid.
+static StringPattern StringPattern_From_Bytes(const uint8_t *data, int64_t count, SCL_STRING_PATTERN_TYPE type)
+{
+    StringPattern result = { 0 };
+    if (!data || count < 0)
+    {
+        SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+        return result;
+    }
+    
+    uint8_t *regex = 0;
+    StringPattern_Internal_Parser parser = { 0 };
+    parser.data = data;
+    parser.count = count;
+    if (type == SCL_STRING_PATTERN_TYPE__GLOB)
+    {
+        regex = (uint8_t *)Mem_Alloc(count * 2 + 3, sizeof(uint8_t));
+        parser.data = regex;
+        parser.count = StringPattern_Internal_GlobToRegex(data, count, regex);
+    }
+    parser.literalRun = (uint8_t *)Mem_Alloc(parser.count + 1, sizeof(uint8_t));
+    parser.literalBest = (uint8_t *)Mem_Alloc(parser.count + 1, sizeof(uint8_t));
+    
+    StringPattern_Internal_Fragment fragment = StringPattern_Internal_ParseAlternation(&parser);
+    if (parser.index < parser.count)
+    {
+        parser.error = 1;
+    }
+    
+    if (!parser.error)
+    {
+        int32_t match = StringPattern_Internal_AddNode(&parser, SCL_STRING_PATTERN_NODE__MATCH, -1, -1);
+        parser.nodes[fragment.end].out = match;
+        
+        result.nodes = parser.nodes;
+        result.nodeCount = parser.nodeCount;
+        result.nodeStart = fragment.start;
+        parser.nodes = 0;
+        
+        // NOTE(s0lly): Bytes that no CHAR node tells apart share one class, which keeps the transition rows short
+        int32_t classRemap[512];
+        result.classCount = 1;
+        for (int32_t nodeIndex = 0; nodeIndex < result.nodeCount; nodeIndex++)
+        {
+            if (result.nodes[nodeIndex].type != SCL_STRING_PATTERN_NODE__CHAR)
+            {
+                continue;
+            }
+            int32_t classCountNew = 0;
+            memset(classRemap, 0xFF, sizeof(classRemap));
+            for (int32_t ch = 0; ch < 256; ch++)
+            {
+                int32_t key = result.byteClasses[ch] * 2 + StringPattern_Internal_SetHas(result.nodes[nodeIndex].set, (uint8_t)ch);
+                if (classRemap[key] < 0)
+                {
+                    classRemap[key] = classCountNew++;
+                }
+                result.byteClasses[ch] = (uint8_t)classRemap[key];
+            }
+            result.classCount = classCountNew;
+        }
+        for (int32_t ch = 255; ch >= 0; ch--)
+        {
+            result.classBytes[result.byteClasses[ch]] = (uint8_t)ch;
+        }
+        
+        if (!parser.literalInvalid && parser.literalBestCount > 0)
+        {
+            result.prefilter = parser.literalBest;
+            result.prefilterCount = parser.literalBestCount;
+            parser.literalBest = 0;
+        }
+        
+        result.scratchNodes = (int32_t *)Mem_Alloc(result.nodeCount, sizeof(int32_t));
+        result.scratchStack = (int32_t *)Mem_Alloc(result.nodeCount, sizeof(int32_t));
+        result.scratchMarks = (uint32_t *)Mem_Alloc(result.nodeCount, sizeof(uint32_t));
+        result.stateStart = -1;
+        StringPattern_Internal_GrowStates(&result, 16);
+    }
+    
+    Mem_Free(parser.nodes);
+    Mem_Free(parser.literalRun);
+    Mem_Free(parser.literalBest);
+    Mem_Free(regex);
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringPattern StringPattern_From_String(String *string, SCL_STRING_PATTERN_TYPE type)
+{
+    StringPattern result = { 0 };
+    if (string && string->e)
+    {
+        result = StringPattern_From_Bytes(string->e, string->count, type);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringPattern StringPattern_From_CStr(const char *cStr, SCL_STRING_PATTERN_TYPE type)
+{
+    StringPattern result = { 0 };
+    if (cStr)
+    {
+        result = StringPattern_From_Bytes((const uint8_t *)cStr, (int64_t)strlen(cStr), type);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): On a match, int64Val holds the offset just past the earliest ending match. Strings without the
+// pattern's longest required literal are rejected by the prefilter before the dfa runs.
+static StringMessage StringPattern_Match(StringPattern *pattern, String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!pattern || !string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!pattern->nodes || !string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (pattern->prefilter && String_Internal_FindBytes(string->e, string->count, pattern->prefilter, pattern->prefilterCount) < 0)
+    {
+        msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
+    }
+    else
+    {
+        msg.int64Val = StringPattern_Internal_Run(pattern, string->e, string->count);
+        msg.code = (msg.int64Val >= 0) ? SCL_STRING_CODE__NO_MESSAGE : SCL_STRING_CODE__FIND_NO_MATCH;
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Builds a new list holding copies of the elements that match, in their original order. Runs on the
+// calling thread as the pattern's dfa cache is not shared - compile one pattern per thread to filter in parallel.
+static StringList StringList_Filter_Pattern(StringList *stringList, StringPattern *pattern)
+{
+    StringList result = { 0 };
+    if (stringList && stringList->e && pattern && pattern->nodes)
+    {
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            if (StringPattern_Match(pattern, &stringList->e[stringIndex]).code == SCL_STRING_CODE__NO_MESSAGE)
+            {
+                StringList_PushCopy(&result, &stringList->e[stringIndex]);
+            }
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+
+// NOTE(s0lly): StringListSnapshot functions
+
+#define SCL_STRING_SNAPSHOT_VERSION 1
+
+static const uint8_t sclStringSnapshotMagic[8] = { 'S', 'C', 'L', 'S', 'N', 'A', 'P', '\0' };
+
+// NOTE(s0lly): Streaming 64 bit checksum in the style of xxHash64 - four independent lanes over 32 byte blocks
+typedef struct String_Internal_Checksum
+{
+    uint64_t lanes[4];
+    uint8_t buffer[32];
+    int64_t bufferCount;
+    int64_t totalCount;
+    
+} String_Internal_Checksum;
+
+#define SCL_STRING_CHECKSUM_PRIME_1 0x9E3779B185EBCA87ull
+#define SCL_STRING_CHECKSUM_PRIME_2 0xC2B2AE3D27D4EB4Full
+#define SCL_STRING_CHECKSUM_PRIME_3 0x165667B19E3779F9ull
+
+static uint64_t String_Internal_Checksum_Rotate(uint64_t value, int32_t bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static void String_Internal_Checksum_Init(String_Internal_Checksum *checksum)
+{
+    Mem_ClearBytes(checksum, sizeof(*checksum));
+    checksum->lanes[0] = SCL_STRING_CHECKSUM_PRIME_1 + SCL_STRING_CHECKSUM_PRIME_2;
+    checksum->lanes[1] = SCL_STRING_CHECKSUM_PRIME_2;
+    checksum->lanes[2] = 0;
+    checksum->lanes[3] = 0 - SCL_STRING_CHECKSUM_PRIME_1;
+}
+
+static void String_Internal_Checksum_Block(String_Internal_Checksum *checksum, const uint8_t *block)
+{
+    for (int32_t laneIndex = 0; laneIndex < 4; laneIndex++)
+    {
+        uint64_t word = 0;
+        memcpy(&word, block + laneIndex * 8, 8);
+        uint64_t lane = checksum->lanes[laneIndex] + word * SCL_STRING_CHECKSUM_PRIME_2;
+        checksum->lanes[laneIndex] = String_Internal_Checksum_Rotate(lane, 31) * SCL_STRING_CHECKSUM_PRIME_1;
+    }
+}
+
+static void String_Internal_Checksum_Update(String_Internal_Checksum *checksum, const uint8_t *data, int64_t count)
+{
+    checksum->totalCount += count;
+    if (checksum->bufferCount > 0)
+    {
+        int64_t copyCount = min(count, 32 - checksum->bufferCount);
+        memcpy(checksum->buffer + checksum->bufferCount, data, copyCount);
+        checksum->bufferCount += copyCount;
+        data += copyCount;
+        count -= copyCount;
+        if (checksum->bufferCount < 32)
+        {
+            return;
+        }
+        String_Internal_Checksum_Block(checksum, checksum->buffer);
+        checksum->bufferCount = 0;
+    }
+    while (count >= 32)
+    {
+        String_Internal_Checksum_Block(checksum, data);
+        data += 32;
+        count -= 32;
+    }
+    memcpy(checksum->buffer, data, count);
+    checksum->bufferCount = count;
+}
+
+static uint64_t String_Internal_Checksum_Final(String_Internal_Checksum *checksum)
+{
+    uint64_t result = String_Internal_Checksum_Rotate(checksum->lanes[0], 1) + String_Internal_Checksum_Rotate(checksum->lanes[1], 7)
+                    + String_Internal_Checksum_Rotate(checksum->lanes[2], 12) + String_Internal_Checksum_Rotate(checksum->lanes[3], 18);
+    result ^= (uint64_t)checksum->totalCount;
+    for (int64_t byteIndex = 0; byteIndex < checksum->bufferCount; byteIndex++)
+    {
+        result = String_Internal_Checksum_Rotate(result ^ (checksum->buffer[byteIndex] * SCL_STRING_CHECKSUM_PRIME_3), 11) * SCL_STRING_CHECKSUM_PRIME_1;
+    }
+    result ^= result >> 33;
+    result *= SCL_STRING_CHECKSUM_PRIME_2;
+    result ^= result >> 29;
+    result *= SCL_STRING_CHECKSUM_PRIME_3;
+    result ^= result >> 32;
+    return result;
+}
+
+// NOTE(s0lly): Writes the list in the snapshot format described at StringListSnapshotHeader. Elements with no
+// data are stored as empty strings.
+static StringMessage StringList_SaveSnapshot(StringList *stringList, String *filename)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    FILE *handle = 0;
+    
+    if (!stringList || !filename)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!filename->e || (!stringList->e && stringList->count > 0))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!(handle = fopen((const char *)filename->e, "wb")))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        StringListSnapshotHeader header = { 0 };
+        memcpy(header.magic, sclStringSnapshotMagic, sizeof(header.magic));
+        header.version = SCL_STRING_SNAPSHOT_VERSION;
+        header.headerSize = (uint32_t)sizeof(StringListSnapshotHeader);
+        header.count = stringList->count;
+        
+        int64_t *offsets = (int64_t *)Mem_Alloc(stringList->count + 1, sizeof(int64_t));
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            String *currentString = &stringList->e[stringIndex];
+            offsets[stringIndex] = header.blobCount;
+            header.blobCount += (currentString->e ? currentString->count : 0) + 1;
+        }
+        offsets[stringList->count] = header.blobCount;
+        
+        String_Internal_Checksum checksum = { 0 };
+        String_Internal_Checksum_Init(&checksum);
+        String_Internal_Checksum_Update(&checksum, (const uint8_t *)offsets, (stringList->count + 1) * sizeof(int64_t));
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            String *currentString = &stringList->e[stringIndex];
+            String_Internal_Checksum_Update(&checksum, currentString->e ? currentString->e : (const uint8_t *)"",
+                                            (currentString->e ? currentString->count : 0) + 1);
+        }
+        header.checksum = String_Internal_Checksum_Final(&checksum);
+        
+        int32_t writeOk = (fwrite(&header, sizeof(header), 1, handle) == 1);
+        writeOk = writeOk && (fwrite(offsets, sizeof(int64_t), stringList->count + 1, handle) == (size_t)(stringList->count + 1));
+        for (int64_t stringIndex = 0; writeOk && stringIndex < stringList->count; stringIndex++)
+        {
+            String *currentString = &stringList->e[stringIndex];
+            int64_t writeCount = (currentString->e ? currentString->count : 0) + 1;
+            writeOk = (fwrite(currentString->e ? currentString->e : (const uint8_t *)"", 1, writeCount, handle) == (size_t)writeCount);
+        }
+        Mem_Free(offsets);
+        
+        if (fclose(handle) != 0 || !writeOk)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+        }
+        else
+        {
+            msg.int64Val = (int64_t)sizeof(header) + (stringList->count + 1) * (int64_t)sizeof(int64_t) + header.blobCount;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage StringList_SaveSnapshot_CStr(StringList *stringList, const char *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String filename = String_From_CStr(cStr).string;
+        msg = StringList_SaveSnapshot(stringList, &filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static void StringListSnapshot_Destroy(StringListSnapshot *snapshot)
+{
+    if (snapshot)
+    {
+        Platform_FileMapping_Close(&snapshot->mapping);
+        Mem_ClearBytes(snapshot, sizeof(*snapshot));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Maps the file and checks only the header and sizes, so loading takes the same time at any file
+// size. Strings are paged in on first access. Call StringListSnapshot_Verify to also check the contents. Returns a
+// zeroed snapshot if the file can't be mapped or isn't a snapshot of this version.
+static StringListSnapshot StringList_LoadSnapshot(String *filename)
+{
+    StringListSnapshot result = { 0 };
+    
+    if (filename && filename->e && Platform_FileMapping_Open(&result.mapping, (const char *)filename->e))
+    {
+        const StringListSnapshotHeader *header = (const StringListSnapshotHeader *)result.mapping.data;
+        // NOTE(s0lly): count and blobCount are bounded by the file size first, so a tampered header can't overflow the
+        // size check below
+        int32_t valid = (result.mapping.count >= (int64_t)sizeof(StringListSnapshotHeader)
+                         && memcmp(header->magic, sclStringSnapshotMagic, sizeof(header->magic)) == 0
+                         && header->version == SCL_STRING_SNAPSHOT_VERSION
+                         && header->headerSize == sizeof(StringListSnapshotHeader)
+                         && header->count >= 0 && header->blobCount >= 0
+                         && header->blobCount <= result.mapping.count
+                         && header->count < result.mapping.count / (int64_t)sizeof(int64_t));
+        if (valid)
+        {
+            int64_t offsetsCount = (header->count + 1) * (int64_t)sizeof(int64_t);
+            valid = (result.mapping.count == (int64_t)sizeof(StringListSnapshotHeader) + offsetsCount + header->blobCount);
+        }
+        
+        if (valid)
+        {
+            result.header = header;
+            result.offsets = (const int64_t *)(result.mapping.data + sizeof(StringListSnapshotHeader));
+            result.blob = (const uint8_t *)(result.offsets + header->count + 1);
+            result.count = header->count;
+        }
+        else
+        {
+            StringListSnapshot_Destroy(&result);
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringListSnapshot StringList_LoadSnapshot_CStr(const char *cStr)
+{
+    StringListSnapshot result = { 0 };
+    
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = StringList_LoadSnapshot(&filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Returns a view into the mapping - it must not be destroyed or written to, and is only valid until
+// the snapshot is destroyed. Entries with out of range offsets come back empty, so unverified files are safe to read.
+static String StringListSnapshot_Get(StringListSnapshot *snapshot, int64_t index)
+{
+    String result = { 0 };
+    if (snapshot && snapshot->offsets && index >= 0 && index < snapshot->count)
+    {
+        int64_t offsetStart = snapshot->offsets[index];
+        int64_t offsetEnd = snapshot->offsets[index + 1];
+        if (offsetStart >= 0 && offsetStart < offsetEnd && offsetEnd <= snapshot->header->blobCount
+            && snapshot->blob[offsetEnd - 1] == '\0')
+        {
+            result.e = (uint8_t *)(snapshot->blob + offsetStart);
+            result.count = offsetEnd - offsetStart - 1;
+            result.countMax = result.count;
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Reads the whole file to check the checksum and that every offset is in order
+static StringMessage StringListSnapshot_Verify(StringListSnapshot *snapshot)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!snapshot)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!snapshot->header)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String_Internal_Checksum checksum = { 0 };
+        String_Internal_Checksum_Init(&checksum);
+        String_Internal_Checksum_Update(&checksum, snapshot->mapping.data + sizeof(StringListSnapshotHeader),
+                                        snapshot->mapping.count - (int64_t)sizeof(StringListSnapshotHeader));
+        
+        int32_t valid = (String_Internal_Checksum_Final(&checksum) == snapshot->header->checksum
+                         && snapshot->offsets[0] == 0 && snapshot->offsets[snapshot->count] == snapshot->header->blobCount);
+        for (int64_t stringIndex = 0; valid && stringIndex < snapshot->count; stringIndex++)
+        {
+            int64_t offsetEnd = snapshot->offsets[stringIndex + 1];
+            valid = (snapshot->offsets[stringIndex] < offsetEnd && snapshot->blob[offsetEnd - 1] == '\0');
+        }
+        msg.code = valid ? SCL_STRING_CODE__NO_MESSAGE : SCL_STRING_CODE__ERROR_INVALID_SNAPSHOT;
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Copies the snapshot into an ordinary, owning StringList
+static StringList StringList_From_StringListSnapshot(StringListSnapshot *snapshot)
+{
+    StringList result = { 0 };
+    if (snapshot && snapshot->count > 0)
+    {
+        result = StringList_From_CountMax(snapshot->count);
+        for (int64_t stringIndex = 0; stringIndex < snapshot->count; stringIndex++)
+        {
+            String view = StringListSnapshot_Get(snapshot, stringIndex);
+            result.e[stringIndex] = view.e ? String_From_String(&view).string : String_From_CStr("").string;
+        }
+        result.count = snapshot->count;
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+
+// NOTE(s0lly): FileWriter functions
+
+#define SCL_STRING_FILE_WRITER_BUFFER_COUNT (1 << 22)
+
+// NOTE(s0lly): bufferCountMax <= 0 uses SCL_STRING_FILE_WRITER_BUFFER_COUNT. The file is created or truncated.
+// Returns a writer with isOpen == 0 if the file can't be opened.
+static FileWriter FileWriter_From_Filename_String(String *filename, int64_t bufferCountMax)
+{
+    FileWriter result = { 0 };
+    if (filename && filename->e && Platform_File_OpenWrite(&result.handle, (const char *)filename->e))
+    {
+        result.isOpen = 1;
+        result.bufferCountMax = (bufferCountMax > 0) ? bufferCountMax : SCL_STRING_FILE_WRITER_BUFFER_COUNT;
+        result.buffer = (uint8_t *)Mem_Alloc(result.bufferCountMax, sizeof(uint8_t));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static FileWriter FileWriter_From_Filename_CStr(const char *cStr, int64_t bufferCountMax)
+{
+    FileWriter result = { 0 };
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = FileWriter_From_Filename_String(&filename, bufferCountMax);
+        String_Destroy(&filename);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringMessage FileWriter_Flush(FileWriter *writer)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!writer)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if (!writer->isOpen)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else if (writer->hasError)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+    }
+    else
+    {
+        if (writer->bufferCount > 0 && !Platform_File_Write(writer->handle, writer->buffer, writer->bufferCount))
+        {
+            writer->hasError = 1;
+            msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+        }
+        writer->bufferCount = 0;
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Small writes are gathered in the buffer. Writes of half the buffer or more go straight from data,
+// together with whatever is already buffered, in a single writev.
+static StringMessage String_Internal_FileWriter_Write(FileWriter *writer, const uint8_t *data, int64_t count)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (writer->hasError)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+    }
+    else if (count <= writer->bufferCountMax - writer->bufferCount)
+    {
+        memcpy(writer->buffer + writer->bufferCount, data, count);
+        writer->bufferCount += count;
+    }
+    else if (count < writer->bufferCountMax / 2)
+    {
+        msg = FileWriter_Flush(writer);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            memcpy(writer->buffer, data, count);
+            writer->bufferCount = count;
+        }
+    }
+    else
+    {
+        if (!Platform_File_WritePair(writer->handle, writer->buffer, writer->bufferCount, data, count))
+        {
+            writer->hasError = 1;
+            msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+        }
+        writer->bufferCount = 0;
+    }
+    
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    {
+        writer->byteCount += count;
+    }
+    return msg;
+}
+
+static StringMessage FileWriter_Write_String(FileWriter *writer, String *string)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!writer)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!writer->isOpen)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Internal_FileWriter_Write(writer, string->e, string->count);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage FileWriter_Write_CStr(FileWriter *writer, const char *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!writer)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!writer->isOpen)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg = String_Internal_FileWriter_Write(writer, (const uint8_t *)cStr, (int64_t)strlen(cStr));
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Writes every element with separator (if not null) between them, e.g. "\n" for a line-per-element file
+static StringMessage FileWriter_Write_StringList(FileWriter *writer, StringList *stringList, String *separator)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!writer)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if (!stringList)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!writer->isOpen)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else if ((!stringList->e && stringList->count > 0) || (separator && !separator->e))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        for (int64_t stringIndex = 0; stringIndex < stringList->count && msg.code == SCL_STRING_CODE__NO_MESSAGE; stringIndex++)
+        {
+            String *currentString = &stringList->e[stringIndex];
+            if (separator && stringIndex > 0)
+            {
+                msg = String_Internal_FileWriter_Write(writer, separator->e, separator->count);
+            }
+            if (currentString->e && msg.code == SCL_STRING_CODE__NO_MESSAGE)
+            {
+                msg = String_Internal_FileWriter_Write(writer, currentString->e, currentString->count);
+            }
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Flushes the buffer and asks the os to commit the file to disk (fsync / FlushFileBuffers)
+static StringMessage FileWriter_Sync(FileWriter *writer)
+{
+    StringMessage msg = FileWriter_Flush(writer);
+    
+    if (msg.code == SCL_STRING_CODE__NO_MESSAGE && !Platform_File_Sync(writer->handle))
+    {
+        writer->hasError = 1;
+        msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Flushes, closes and frees the writer. On success, int64Val holds the total bytes written.
+static StringMessage FileWriter_Close(FileWriter *writer)
+{
+    StringMessage msg = FileWriter_Flush(writer);
+    
+    if (writer && writer->isOpen)
+    {
+        if (!Platform_File_Close(writer->handle) && msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+        }
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg.int64Val = writer->byteCount;
+        }
+        Mem_Free(writer->buffer);
+        Mem_ClearBytes(writer, sizeof(*writer));
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Writes at the current position of an already open File
+static StringMessage String_To_File(String *string, File *file)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!string)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!file)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!file->handle)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else if (fwrite(string->e, 1, string->count, file->handle) != (size_t)string->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+    }
+    else
+    {
+        file->cursor += (int32_t)string->count;
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Writes every element with separator (if not null) between them at the current position of an
+// already open File. Goes through stdio's buffer - the Filename variants below make far fewer system calls.
+static StringMessage StringList_To_File(StringList *stringList, String *separator, File *file)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!stringList)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!file)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else if ((!stringList->e && stringList->count > 0) || (separator && !separator->e))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!file->handle)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        for (int64_t stringIndex = 0; stringIndex < stringList->count && msg.code == SCL_STRING_CODE__NO_MESSAGE; stringIndex++)
+        {
+            String *currentString = &stringList->e[stringIndex];
+            if (separator && stringIndex > 0)
+            {
+                msg = String_To_File(separator, file);
+            }
+            if (currentString->e && msg.code == SCL_STRING_CODE__NO_MESSAGE)
+            {
+                msg = String_To_File(currentString, file);
+            }
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Creates or truncates the file and writes the string to it. On success, int64Val holds the bytes written.
+static StringMessage String_To_Filename_String(String *string, String *filename)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!string || !filename)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!string->e || !filename->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        // NOTE(s0lly): A minimal buffer - the string itself is written directly
+        FileWriter writer = FileWriter_From_Filename_String(filename, 1);
+        msg = FileWriter_Write_String(&writer, string);
+        StringMessage closeMsg = FileWriter_Close(&writer);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = closeMsg;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage String_To_Filename_CStr(String *string, const char *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String filename = String_From_CStr(cStr).string;
+        msg = String_To_Filename_String(string, &filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Creates or truncates the file and writes the list to it through a FileWriter. On success, int64Val
+// holds the bytes written.
+static StringMessage StringList_To_Filename_String(StringList *stringList, String *separator, String *filename)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!stringList || !filename)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!filename->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        FileWriter writer = FileWriter_From_Filename_String(filename, 0);
+        msg = FileWriter_Write_StringList(&writer, stringList, separator);
+        StringMessage closeMsg = FileWriter_Close(&writer);
+        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            msg = closeMsg;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage StringList_To_Filename_CStr(StringList *stringList, String *separator, const char *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String filename = String_From_CStr(cStr).string;
+        msg = StringList_To_Filename_String(stringList, separator, &filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+
+// NOTE(s0lly): FileReadAhead functions
+
+#define SCL_STRING_READ_AHEAD_BUFFER_COUNT (1 << 20)
+
+static void FileReadAhead_Internal_Signal(FileReadAhead *reader)
+{
+    Platform_Mutex_Lock(&reader->mutex);
+    Platform_CondVar_Broadcast(&reader->condVar);
+    Platform_Mutex_Unlock(&reader->mutex);
+}
+
+// NOTE(s0lly): Chunks are handed over by publishing produced / consumed with release stores - the mutex is only
+// taken to sleep when the ring is full (reader thread) or empty (caller), and to wake the other side.
+static void FileReadAhead_Internal_ThreadMain(void *arg)
+{
+    FileReadAhead *reader = (FileReadAhead *)arg;
+    int64_t produced = 0;
+    
+    while (!Platform_Atomic_LoadInt64(&reader->stop))
+    {
+        if (produced - Platform_Atomic_LoadInt64(&reader->consumed) >= SCL_STRING_READ_AHEAD_SLOT_COUNT)
+        {
+            Platform_Mutex_Lock(&reader->mutex);
+            while (produced - Platform_Atomic_LoadInt64(&reader->consumed) >= SCL_STRING_READ_AHEAD_SLOT_COUNT
+                   && !Platform_Atomic_LoadInt64(&reader->stop))
+            {
+                Platform_CondVar_Wait(&reader->condVar, &reader->mutex);
+            }
+            Platform_Mutex_Unlock(&reader->mutex);
+            continue;
+        }
+        
+        int64_t slotIndex = produced % SCL_STRING_READ_AHEAD_SLOT_COUNT;
+        int64_t readCount = (int64_t)fread(reader->slotData[slotIndex], 1, reader->slotCountMax, reader->file->handle);
+        reader->slotCounts[slotIndex] = readCount;
+        if (readCount > 0)
+        {
+            produced++;
+            Platform_Atomic_StoreInt64(&reader->produced, produced);
+        }
+        if (readCount < reader->slotCountMax)
+        {
+            Platform_Atomic_StoreInt64(&reader->finished, 1);
+        }
+        FileReadAhead_Internal_Signal(reader);
+        
+        if (readCount < reader->slotCountMax)
+        {
+            break;
+        }
+    }
+}
+
+// NOTE(s0lly): Starts a thread reading the file from its cursor into SCL_STRING_READ_AHEAD_SLOT_COUNT buffers of
+// bufferCountMax bytes (<= 0 uses SCL_STRING_READ_AHEAD_BUFFER_COUNT), staying up to that many chunks ahead of
+// FileReadAhead_Next. The file must not be used elsewhere until FileReadAhead_Destroy.
+static FileReadAhead *FileReadAhead_Create(File *file, int64_t bufferCountMax)
+{
+    FileReadAhead *reader = 0;
+    if (file && file->handle && fseek(file->handle, file->cursor, SEEK_SET) == 0)
+    {
+        reader = (FileReadAhead *)Mem_Alloc(1, sizeof(FileReadAhead));
+        reader->file = file;
+        reader->slotCountMax = (bufferCountMax > 0) ? bufferCountMax : SCL_STRING_READ_AHEAD_BUFFER_COUNT;
+        for (int32_t slotIndex = 0; slotIndex < SCL_STRING_READ_AHEAD_SLOT_COUNT; slotIndex++)
+        {
+            reader->slotData[slotIndex] = (uint8_t *)Mem_Alloc(reader->slotCountMax, sizeof(uint8_t));
+        }
+        Platform_Mutex_Init(&reader->mutex);
+        Platform_CondVar_Init(&reader->condVar);
+        
+        if (!Platform_Thread_Create(&reader->thread, FileReadAhead_Internal_ThreadMain, reader))
+        {
+            // NOTE(s0lly): Nothing to read ahead with - callers fall back to reading on their own thread
+            Platform_CondVar_Destroy(&reader->condVar);
+            Platform_Mutex_Destroy(&reader->mutex);
+            for (int32_t slotIndex = 0; slotIndex < SCL_STRING_READ_AHEAD_SLOT_COUNT; slotIndex++)
+            {
+                Mem_Free(reader->slotData[slotIndex]);
+            }
+            Mem_Free(reader);
+            reader = 0;
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return reader;
+}
+
+// NOTE(s0lly): Hands back the previous chunk and returns the next one as a view in msg.string, valid until the next
+// call. Returns SCL_STRING_CODE__FILE_ENCOUNTERED_EOF once the file is exhausted.
+static StringMessage FileReadAhead_Next(FileReadAhead *reader)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!reader)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t consumed = reader->consumed;
+        if (reader->isHoldingSlot)
+        {
+            consumed++;
+            Platform_Atomic_StoreInt64(&reader->consumed, consumed);
+            reader->isHoldingSlot = 0;
+            FileReadAhead_Internal_Signal(reader);
+        }
+        
+        if (Platform_Atomic_LoadInt64(&reader->produced) == consumed)
+        {
+            Platform_Mutex_Lock(&reader->mutex);
+            while (Platform_Atomic_LoadInt64(&reader->produced) == consumed && !Platform_Atomic_LoadInt64(&reader->finished))
+            {
+                Platform_CondVar_Wait(&reader->condVar, &reader->mutex);
+            }
+            Platform_Mutex_Unlock(&reader->mutex);
+        }
+        
+        if (Platform_Atomic_LoadInt64(&reader->produced) > consumed)
+        {
+            int64_t slotIndex = consumed % SCL_STRING_READ_AHEAD_SLOT_COUNT;
+            msg.string.e = reader->slotData[slotIndex];
+            msg.string.count = reader->slotCounts[slotIndex];
+            msg.string.countMax = reader->slotCounts[slotIndex];
+            reader->byteCount += reader->slotCounts[slotIndex];
+            reader->isHoldingSlot = 1;
+        }
+        else
+        {
+            msg.code = SCL_STRING_CODE__FILE_ENCOUNTERED_EOF;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Stops and joins the reader thread. The file's cursor is moved past the chunks returned by
+// FileReadAhead_Next.
+static void FileReadAhead_Destroy(FileReadAhead *reader)
+{
+    if (reader)
+    {
+        Platform_Atomic_StoreInt64(&reader->stop, 1);
+        FileReadAhead_Internal_Signal(reader);
+        Platform_Thread_Join(&reader->thread);
+        
+        reader->file->cursor += (int32_t)reader->byteCount;
+        fseek(reader->file->handle, reader->file->cursor, SEEK_SET);
+        
+        Platform_CondVar_Destroy(&reader->condVar);
+        Platform_Mutex_Destroy(&reader->mutex);
+        for (int32_t slotIndex = 0; slotIndex < SCL_STRING_READ_AHEAD_SLOT_COUNT; slotIndex++)
+        {
+            Mem_Free(reader->slotData[slotIndex]);
+        }
+        Mem_Free(reader);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Grows the element array by moving the String structs rather than copying their contents
+static void StringList_Internal_PushMove(StringList *stringList, String *string)
+{
+    if (stringList->count >= stringList->countMax)
+    {
+        int64_t countMaxNew = max(stringList->countMax * 2, 16);
+        String *eNew = (String *)Mem_Alloc(countMaxNew, sizeof(String));
+        if (stringList->e)
+        {
+            SCL_STRING_STATS_REALLOC(stringList->count * sizeof(String));
+            memcpy(eNew, stringList->e, stringList->count * sizeof(String));
+            Mem_Free(stringList->e);
+        }
+        stringList->e = eNew;
+        stringList->countMax = countMaxNew;
+    }
+    stringList->e[stringList->count++] = *string;
+    Mem_ClearBytes(string, sizeof(*string));
+}
+
+// NOTE(s0lly): Pushes every complete line of data, the first one prefixed by carry. The bytes after the last newline
+// are left in carry for the next call.
+static void StringList_Internal_PushLines(StringList *stringList, String *carry, const uint8_t *data, int64_t count)
+{
+    const uint8_t *scan = data;
+    const uint8_t *scanEnd = data + count;
+    const uint8_t *lineEnd = 0;
+    while (scan < scanEnd && (lineEnd = (const uint8_t *)memchr(scan, '\n', scanEnd - scan)) != 0)
+    {
+        String line = { 0 };
+        if (carry->count > 0)
+        {
+            line = String_Internal_CopyStringIntoMessage(carry->e, carry->count, carry->count + (lineEnd - scan)).string;
+            memcpy(line.e + line.count, scan, lineEnd - scan);
+            line.count += lineEnd - scan;
+            carry->count = 0;
+        }
+        else
+        {
+            line = String_Internal_CopyStringIntoMessage(scan, lineEnd - scan, lineEnd - scan).string;
+        }
+        StringList_Internal_PushMove(stringList, &line);
+        scan = lineEnd + 1;
+    }
+    String_Append_Unchecked(carry, (uint8_t *)scan, scanEnd - scan);
+}
+
+// NOTE(s0lly): Same result as StringList_From_File, but the next chunks of the file are read on a background
+// thread while the current one is split into lines, so the load takes about as long as the slower of the two.
+// Falls back to StringList_From_File if the thread can't be started.
+static StringList StringList_From_File_ReadAhead(File *file)
+{
+    StringList result = { 0 };
+    FileReadAhead *reader = FileReadAhead_Create(file, 0);
+    
+    if (reader)
+    {
+        String carry = String_From_CountMax(0).string;
+        StringMessage chunkMsg = FileReadAhead_Next(reader);
+        while (chunkMsg.code == SCL_STRING_CODE__NO_MESSAGE)
+        {
+            StringList_Internal_PushLines(&result, &carry, chunkMsg.string.e, chunkMsg.string.count);
+            chunkMsg = FileReadAhead_Next(reader);
+        }
+        
+        if (carry.count > 0)
+        {
+            carry.e[carry.count] = '\0';
+            StringList_Internal_PushMove(&result, &carry);
+        }
+        String_Destroy(&carry);
+        FileReadAhead_Destroy(reader);
+    }
+    else if (file && file->handle)
+    {
+        result = StringList_From_File(file);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringList StringList_From_Filename_ReadAhead_String(String *filename)
+{
+    StringList result = { 0 };
+    
+    if (filename && filename->e)
+    {
+        File file = { 0 };
+        file.handle = fopen((const char *)filename->e, "rb");
+        if (file.handle)
+        {
+            result = StringList_From_File_ReadAhead(&file);
+            fclose(file.handle);
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringList StringList_From_Filename_ReadAhead_CStr(const char *cStr)
+{
+    StringList result = { 0 };
+    
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = StringList_From_Filename_ReadAhead_String(&filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+
+// NOTE(s0lly): LineIndex functions
+
+#define SCL_STRING_LINE_INDEX_STRIDE 64
+#define SCL_STRING_LINE_INDEX_VERSION 1
+
+static const uint8_t sclStringLineIndexMagic[8] = { 'S', 'C', 'L', 'L', 'I', 'D', 'X', '\0' };
+
+static void LineIndex_Destroy(LineIndex *lineIndex)
+{
+    if (lineIndex)
+    {
+        Platform_FileMapping_Close(&lineIndex->mapping);
+        Mem_Free(lineIndex->offsets);
+        Mem_ClearBytes(lineIndex, sizeof(*lineIndex));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+static void LineIndex_Internal_PushOffset(LineIndex *lineIndex, int64_t *offsetCountMax, int64_t offset)
+{
+    if (lineIndex->offsetCount >= *offsetCountMax)
+    {
+        int64_t offsetCountMaxNew = max(*offsetCountMax * 2, 1024);
+        int64_t *offsetsNew = (int64_t *)Mem_Alloc(offsetCountMaxNew, sizeof(int64_t));
+        if (lineIndex->offsets)
+        {
+            SCL_STRING_STATS_REALLOC(lineIndex->offsetCount * sizeof(int64_t));
+            memcpy(offsetsNew, lineIndex->offsets, lineIndex->offsetCount * sizeof(int64_t));
+            Mem_Free(lineIndex->offsets);
+        }
+        lineIndex->offsets = offsetsNew;
+        *offsetCountMax = offsetCountMaxNew;
+    }
+    lineIndex->offsets[lineIndex->offsetCount++] = offset;
+}
+
+// NOTE(s0lly): Records the start of every SCL_STRING_LINE_INDEX_STRIDE-th line. With sse2, newlines in 32 byte
+// blocks are only counted, and positions are looked at in the one block per stride that holds the boundary.
+static void LineIndex_Internal_Build(LineIndex *lineIndex)
+{
+    const uint8_t *data = lineIndex->mapping.data;
+    int64_t byteCount = lineIndex->mapping.count;
+    int64_t offsetCountMax = 0;
+    int64_t newlineCount = 0;
+    int64_t index = 0;
+    
+    LineIndex_Internal_PushOffset(lineIndex, &offsetCountMax, 0);
+#if defined(SCL_STRING_SSE2)
+    __m128i newline = _mm_set1_epi8('\n');
+    for (; index + 32 <= byteCount; index += 32)
+    {
+        __m128i blockLow = _mm_loadu_si128((const __m128i *)(data + index));
+        __m128i blockHigh = _mm_loadu_si128((const __m128i *)(data + index + 16));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(blockLow, newline))
+                      | ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(blockHigh, newline)) << 16);
+        int32_t maskCount = Platform_PopCount32(mask);
+        if ((newlineCount % SCL_STRING_LINE_INDEX_STRIDE) + maskCount < SCL_STRING_LINE_INDEX_STRIDE)
+        {
+            newlineCount += maskCount;
+            continue;
+        }
+        while (mask)
+        {
+            newlineCount++;
+            if (newlineCount % SCL_STRING_LINE_INDEX_STRIDE == 0)
+            {
+                LineIndex_Internal_PushOffset(lineIndex, &offsetCountMax, index + Platform_CountTrailingZeros32(mask) + 1);
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; index < byteCount; index++)
+    {
+        if (data[index] == '\n')
+        {
+            newlineCount++;
+            if (newlineCount % SCL_STRING_LINE_INDEX_STRIDE == 0)
+            {
+                LineIndex_Internal_PushOffset(lineIndex, &offsetCountMax, index + 1);
+            }
+        }
+    }
+    
+    lineIndex->count = newlineCount + (data[byteCount - 1] != '\n');
+    if (lineIndex->offsetCount > 0 && lineIndex->offsets[lineIndex->offsetCount - 1] >= byteCount)
+    {
+        // NOTE(s0lly): A boundary on the file's final newline starts no line
+        lineIndex->offsetCount--;
+    }
+}
+
+// NOTE(s0lly): Maps the file and scans it once for newlines, keeping one offset per SCL_STRING_LINE_INDEX_STRIDE
+// lines. Lines follow StringList_From_File: split on '\n', which is dropped, with a final unterminated line kept.
+// Returns a zeroed index if the file can't be mapped (this includes empty files).
+static LineIndex LineIndex_From_Filename_String(String *filename)
+{
+    LineIndex result = { 0 };
+    if (filename && filename->e && Platform_FileMapping_Open(&result.mapping, (const char *)filename->e))
+    {
+        LineIndex_Internal_Build(&result);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static LineIndex LineIndex_From_Filename_CStr(const char *cStr)
+{
+    LineIndex result = { 0 };
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = LineIndex_From_Filename_String(&filename);
+        String_Destroy(&filename);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Returns a view of line index inside the mapping, without its '\n'. Unlike other views the line is
+// NOT NUL-terminated - use LineIndex_Get_Copy where a C string is needed. Valid until the index is destroyed.
+static String LineIndex_Get(LineIndex *lineIndex, int64_t index)
+{
+    String result = { 0 };
+    if (lineIndex && lineIndex->offsets && index >= 0 && index < lineIndex->count)
+    {
+        const uint8_t *data = lineIndex->mapping.data;
+        int64_t byteCount = lineIndex->mapping.count;
+        int64_t lineStart = lineIndex->offsets[index / SCL_STRING_LINE_INDEX_STRIDE];
+        for (int64_t skipIndex = 0; skipIndex < index % SCL_STRING_LINE_INDEX_STRIDE && lineStart < byteCount; skipIndex++)
+        {
+            const uint8_t *skipEnd = (const uint8_t *)memchr(data + lineStart, '\n', byteCount - lineStart);
+            lineStart = skipEnd ? (int64_t)(skipEnd - data) + 1 : byteCount;
+        }
+        
+        // NOTE(s0lly): Only reachable with an index that doesn't match the file's contents
+        if (lineStart < byteCount)
+        {
+            const uint8_t *lineEnd = (const uint8_t *)memchr(data + lineStart, '\n', byteCount - lineStart);
+            result.e = (uint8_t *)(data + lineStart);
+            result.count = (lineEnd ? (int64_t)(lineEnd - data) : byteCount) - lineStart;
+            result.countMax = result.count;
+        }
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringMessage LineIndex_Get_Copy(LineIndex *lineIndex, int64_t index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!lineIndex)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!lineIndex->offsets)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (index < 0 || index >= lineIndex->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String view = LineIndex_Get(lineIndex, index);
+        msg = String_Internal_CopyStringIntoMessage(view.e, view.count, view.count);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Writes the offsets so LineIndex_From_Filename_Persisted_String can skip the scan next time
+static StringMessage LineIndex_Save(LineIndex *lineIndex, String *indexFilename)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    FILE *handle = 0;
+    
+    if (!lineIndex || !indexFilename)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!lineIndex->offsets || !indexFilename->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!(handle = fopen((const char *)indexFilename->e, "wb")))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        LineIndexHeader header = { 0 };
+        memcpy(header.magic, sclStringLineIndexMagic, sizeof(header.magic));
+        header.version = SCL_STRING_LINE_INDEX_VERSION;
+        header.stride = SCL_STRING_LINE_INDEX_STRIDE;
+        header.byteCount = lineIndex->mapping.count;
+        header.count = lineIndex->count;
+        header.offsetCount = lineIndex->offsetCount;
+        
+        String_Internal_Checksum checksum = { 0 };
+        String_Internal_Checksum_Init(&checksum);
+        String_Internal_Checksum_Update(&checksum, (const uint8_t *)lineIndex->offsets, lineIndex->offsetCount * sizeof(int64_t));
+        header.checksum = String_Internal_Checksum_Final(&checksum);
+        
+        int32_t writeOk = (fwrite(&header, sizeof(header), 1, handle) == 1);
+        writeOk = writeOk && (fwrite(lineIndex->offsets, sizeof(int64_t), lineIndex->offsetCount, handle) == (size_t)lineIndex->offsetCount);
+        if (fclose(handle) != 0 || !writeOk)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Reads a saved index if it matches the file, otherwise builds the index and saves it to indexFilename.
+// A saved index is matched by its checksum, the file's size and a check that its last offset follows a newline,
+// so an edit that keeps the file size the same needs the index file removed.
+static LineIndex LineIndex_From_Filename_Persisted_String(String *filename, String *indexFilename)
+{
+    LineIndex result = { 0 };
+    
+    if (filename && filename->e && indexFilename && indexFilename->e
+        && Platform_FileMapping_Open(&result.mapping, (const char *)filename->e))
+    {
+        FILE *handle = fopen((const char *)indexFilename->e, "rb");
+        if (handle)
+        {
+            LineIndexHeader header = { 0 };
+            int32_t valid = (fread(&header, sizeof(header), 1, handle) == 1
+                             && memcmp(header.magic, sclStringLineIndexMagic, sizeof(header.magic)) == 0
+                             && header.version == SCL_STRING_LINE_INDEX_VERSION
+                             && header.stride == SCL_STRING_LINE_INDEX_STRIDE
+                             && header.byteCount == result.mapping.count
+                             && header.offsetCount > 0 && header.offsetCount <= header.byteCount
+                             && header.count > (header.offsetCount - 1) * SCL_STRING_LINE_INDEX_STRIDE
+                             && header.count <= header.offsetCount * SCL_STRING_LINE_INDEX_STRIDE
+                             && header.count <= header.byteCount);
+            if (valid)
+            {
+                result.offsets = (int64_t *)Mem_Alloc(header.offsetCount, sizeof(int64_t));
+                valid = (fread(result.offsets, sizeof(int64_t), header.offsetCount, handle) == (size_t)header.offsetCount);
+                
+                String_Internal_Checksum checksum = { 0 };
+                String_Internal_Checksum_Init(&checksum);
+                String_Internal_Checksum_Update(&checksum, (const uint8_t *)result.offsets, header.offsetCount * sizeof(int64_t));
+                int64_t offsetLast = result.offsets[header.offsetCount - 1];
+                valid = valid && String_Internal_Checksum_Final(&checksum) == header.checksum && result.offsets[0] == 0
+                        && offsetLast >= 0 && offsetLast < result.mapping.count
+                        && (header.offsetCount == 1 || result.mapping.data[offsetLast - 1] == '\n');
+            }
+            fclose(handle);
+            
+            if (valid)
+            {
+                result.offsetCount = header.offsetCount;
+                result.count = header.count;
+            }
+            else
+            {
+                Mem_Free(result.offsets);
+                result.offsets = 0;
+            }
+        }
+        
+        if (!result.offsets)
+        {
+            LineIndex_Internal_Build(&result);
+            LineIndex_Save(&result, indexFilename);
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static LineIndex LineIndex_From_Filename_Persisted_CStr(const char *cStr, const char *indexCStr)
+{
+    LineIndex result = { 0 };
+    if (cStr && indexCStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        String indexFilename = String_From_CStr(indexCStr).string;
+        result = LineIndex_From_Filename_Persisted_String(&filename, &indexFilename);
+        String_Destroy(&indexFilename);
+        String_Destroy(&filename);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+
+// NOTE(s0lly): Edit distance functions
+
+#define SCL_STRING_EDIT_BIGRAM_TABLE_COUNT 4096
+
+// NOTE(s0lly): Match masks of a pattern for Myers' bit-parallel algorithm - 64 pattern positions per block, and for
+// each block and byte value the positions holding that byte
+typedef struct String_Internal_EditPattern
+{
+    uint64_t *peq;
+    int64_t count;
+    int64_t blockCount;
+    
+} String_Internal_EditPattern;
+
+static String_Internal_EditPattern String_Internal_EditPattern_From_Bytes(const uint8_t *data, int64_t count)
+{
+    String_Internal_EditPattern result = { 0 };
+    result.count = count;
+    result.blockCount = (count + 63) / 64;
+    if (result.blockCount > 0)
+    {
+        result.peq = (uint64_t *)Mem_Alloc(result.blockCount * 256, sizeof(uint64_t));
+        for (int64_t index = 0; index < count; index++)
+        {
+            result.peq[(index / 64) * 256 + data[index]] |= (uint64_t)1 << (index % 64);
+        }
+    }
+    return result;
+}
+
+// NOTE(s0lly): Levenshtein distance between the pattern and text, or maxDistance + 1 as soon as the distance is
+// known to exceed maxDistance. Global distance after Hyyrö, with the carry between blocks as in edlib. scratch holds
+// 2 * blockCount words.
+static int64_t String_Internal_EditDistance_Run(String_Internal_EditPattern *pattern, const uint8_t *text, int64_t textCount,
+                                                int64_t maxDistance, uint64_t *scratch)
+{
+    int64_t lengthDifference = (pattern->count > textCount) ? pattern->count - textCount : textCount - pattern->count;
+    if (lengthDifference > maxDistance)
+    {
+        return maxDistance + 1;
+    }
+    if (pattern->count == 0)
+    {
+        return textCount;
+    }
+    
+    int64_t score = pattern->count;
+    uint64_t highBit = (uint64_t)1 << ((pattern->count - 1) % 64);
+    
+    if (pattern->blockCount == 1)
+    {
+        uint64_t pv = ~(uint64_t)0;
+        uint64_t mv = 0;
+        for (int64_t textIndex = 0; textIndex < textCount; textIndex++)
+        {
+            uint64_t eq = pattern->peq[text[textIndex]];
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            score += ((ph & highBit) != 0) - ((mh & highBit) != 0);
+            if (score - (textCount - textIndex - 1) > maxDistance)
+            {
+                return maxDistance + 1;
+            }
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+        }
+        return (score > maxDistance) ? maxDistance + 1 : score;
+    }
+    
+    uint64_t *pvs = scratch;
+    uint64_t *mvs = scratch + pattern->blockCount;
+    for (int64_t blockIndex = 0; blockIndex < pattern->blockCount; blockIndex++)
+    {
+        pvs[blockIndex] = ~(uint64_t)0;
+        mvs[blockIndex] = 0;
+    }
+    
+    for (int64_t textIndex = 0; textIndex < textCount; textIndex++)
+    {
+        const uint64_t *peq = pattern->peq + text[textIndex];
+        int32_t horizontal = 1;
+        for (int64_t blockIndex = 0; blockIndex < pattern->blockCount; blockIndex++)
+        {
+            uint64_t pv = pvs[blockIndex];
+            uint64_t mv = mvs[blockIndex];
+            uint64_t horizontalIsNegative = (horizontal < 0);
+            uint64_t eq = peq[blockIndex * 256];
+            uint64_t xv = eq | mv;
+            eq |= horizontalIsNegative;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            
+            uint64_t blockHighBit = (blockIndex == pattern->blockCount - 1) ? highBit : ((uint64_t)1 << 63);
+            int32_t horizontalOut = ((ph & blockHighBit) != 0) - ((mh & blockHighBit) != 0);
+            
+            ph = (ph << 1) | (uint64_t)(horizontal > 0);
+            mh = (mh << 1) | horizontalIsNegative;
+            pvs[blockIndex] = mh | ~(xv | ph);
+            mvs[blockIndex] = ph & xv;
+            horizontal = horizontalOut;
+        }
+        score += horizontal;
+        if (score - (textCount - textIndex - 1) > maxDistance)
+        {
+            return maxDistance + 1;
+        }
+    }
+    return (score > maxDistance) ? maxDistance + 1 : score;
+}
+
+// NOTE(s0lly): int64Val holds the Levenshtein distance (insertions, deletions and substitutions of single bytes)
+static StringMessage String_EditDistance(String *stringA, String *stringB)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!stringA || !stringB)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!stringA->e || !stringB->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        // NOTE(s0lly): The shorter string is the pattern, so fewer blocks are needed
+        String *patternString = (stringA->count <= stringB->count) ? stringA : stringB;
+        String *textString = (patternString == stringA) ? stringB : stringA;
+        String_Internal_EditPattern pattern = String_Internal_EditPattern_From_Bytes(patternString->e, patternString->count);
+        uint64_t *scratch = (uint64_t *)Mem_Alloc(max(pattern.blockCount, 1) * 2, sizeof(uint64_t));
+        msg.int64Val = String_Internal_EditDistance_Run(&pattern, textString->e, textString->count, textString->count, scratch);
+        Mem_Free(scratch);
+        Mem_Free(pattern.peq);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): As String_EditDistance, but stops as soon as the distance is known to exceed maxDistance, in which
+// case the code is SCL_STRING_CODE__FIND_NO_MATCH and int64Val is maxDistance + 1
+static StringMessage String_EditDistance_Max(String *stringA, String *stringB, int64_t maxDistance)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    
+    if (!stringA || !stringB)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!stringA->e || !stringB->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (maxDistance < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String *patternString = (stringA->count <= stringB->count) ? stringA : stringB;
+        String *textString = (patternString == stringA) ? stringB : stringA;
+        String_Internal_EditPattern pattern = String_Internal_EditPattern_From_Bytes(patternString->e, patternString->count);
+        uint64_t *scratch = (uint64_t *)Mem_Alloc(max(pattern.blockCount, 1) * 2, sizeof(uint64_t));
+        msg.int64Val = String_Internal_EditDistance_Run(&pattern, textString->e, textString->count, maxDistance, scratch);
+        msg.code = (msg.int64Val > maxDistance) ? SCL_STRING_CODE__FIND_NO_MATCH : SCL_STRING_CODE__NO_MESSAGE;
+        Mem_Free(scratch);
+        Mem_Free(pattern.peq);
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+typedef struct StringList_Internal_FuzzyContext
+{
+    StringList *stringList;
+    String_Internal_EditPattern pattern;
+    int64_t maxDistance;
+    int64_t *distances;
+    uint64_t *scratch;
+    int64_t scratchCount;
+    
+    // NOTE(s0lly): Hashed bigram counts of the query (one copy per worker) and how many bigrams a candidate must
+    // share with it. The counts are exact (never saturate), since the bound assumes every query bigram is counted.
+    uint32_t *bigramCounts;
+    uint32_t *bigramsTaken;
+    int64_t bigramsRequired;
+    
+} StringList_Internal_FuzzyContext;
+
+static uint32_t StringList_Internal_FuzzyBigram(const uint8_t *data)
+{
+    return ((uint32_t)data[0] * 31u + (uint32_t)data[1] * 131u) % SCL_STRING_EDIT_BIGRAM_TABLE_COUNT;
+}
+
+// NOTE(s0lly): q-gram lemma: strings within distance k share at least (count - 1) - 2k bigrams. Hash collisions only
+// ever make the count larger, so no match is filtered out. The counts taken are put back before returning.
+static int32_t StringList_Internal_FuzzyBigramFilter(StringList_Internal_FuzzyContext *fuzzy, String *candidate, int32_t workerIndex)
+{
+    uint32_t *bigramCounts = fuzzy->bigramCounts + (int64_t)workerIndex * SCL_STRING_EDIT_BIGRAM_TABLE_COUNT;
+    uint32_t *bigramsTaken = fuzzy->bigramsTaken + (int64_t)workerIndex * fuzzy->bigramsRequired;
+    int64_t shared = 0;
+    for (int64_t index = 0; index + 1 < candidate->count && shared < fuzzy->bigramsRequired; index++)
+    {
+        uint32_t bigram = StringList_Internal_FuzzyBigram(candidate->e + index);
+        if (bigramCounts[bigram])
+        {
+            bigramCounts[bigram]--;
+            bigramsTaken[shared++] = bigram;
+        }
+    }
+    for (int64_t index = 0; index < shared; index++)
+    {
+        bigramCounts[bigramsTaken[index]]++;
+    }
+    return (shared >= fuzzy->bigramsRequired);
+}
+
+static void StringList_Internal_FuzzyRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    StringList_Internal_FuzzyContext *fuzzy = (StringList_Internal_FuzzyContext *)context;
+    uint64_t *scratch = fuzzy->scratch + workerIndex * fuzzy->scratchCount;
+    for (int64_t stringIndex = indexStart; stringIndex < indexEnd; stringIndex++)
+    {
+        String *candidate = &fuzzy->stringList->e[stringIndex];
+        int64_t lengthDifference = candidate->count - fuzzy->pattern.count;
+        fuzzy->distances[stringIndex] = fuzzy->maxDistance + 1;
+        if (!candidate->e || lengthDifference > fuzzy->maxDistance || -lengthDifference > fuzzy->maxDistance
+            || (fuzzy->bigramCounts && !StringList_Internal_FuzzyBigramFilter(fuzzy, candidate, workerIndex)))
+        {
+            continue;
+        }
+        fuzzy->distances[stringIndex] = String_Internal_EditDistance_Run(&fuzzy->pattern, candidate->e, candidate->count,
+                                                                         fuzzy->maxDistance, scratch);
+    }
+}
+
+static int StringList_Internal_CompareFuzzyMatches(const void *a, const void *b)
+{
+    const StringFuzzyMatch *matchA = (const StringFuzzyMatch *)a;
+    const StringFuzzyMatch *matchB = (const StringFuzzyMatch *)b;
+    if (matchA->distance != matchB->distance)
+    {
+        return (matchA->distance > matchB->distance) - (matchA->distance < matchB->distance);
+    }
+    return (matchA->index > matchB->index) - (matchA->index < matchB->index);
+}
+
+static void StringFuzzyMatches_Destroy(StringFuzzyMatches *matches)
+{
+    if (matches)
+    {
+        Mem_Free(matches->e);
+        Mem_ClearBytes(matches, sizeof(*matches));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Finds every element within maxDistance edits of query. Candidates are rejected by length and by shared
+// bigrams before the distance is computed, and the list is split between the pool's workers (null runs serially).
+static StringFuzzyMatches StringList_FuzzyFind(StringThreadPool *pool, StringList *stringList, String *query, int64_t maxDistance)
+{
+    StringFuzzyMatches result = { 0 };
+    if (stringList && stringList->e && stringList->count > 0 && query && query->e && maxDistance >= 0)
+    {
+        StringList_Internal_FuzzyContext fuzzy = { 0 };
+        fuzzy.stringList = stringList;
+        fuzzy.pattern = String_Internal_EditPattern_From_Bytes(query->e, query->count);
+        fuzzy.maxDistance = maxDistance;
+        fuzzy.distances = (int64_t *)Mem_Alloc(stringList->count, sizeof(int64_t));
+        fuzzy.scratchCount = max(fuzzy.pattern.blockCount, 1) * 2;
+        fuzzy.scratch = (uint64_t *)Mem_Alloc(fuzzy.scratchCount * StringThreadPool_Get_ThreadCount(pool), sizeof(uint64_t));
+        
+        fuzzy.bigramsRequired = (query->count - 1) - 2 * maxDistance;
+        if (fuzzy.bigramsRequired > 0 && query->count - 1 <= (int64_t)UINT32_MAX)
+        {
+            int32_t threadCount = StringThreadPool_Get_ThreadCount(pool);
+            fuzzy.bigramCounts = (uint32_t *)Mem_Alloc(threadCount * SCL_STRING_EDIT_BIGRAM_TABLE_COUNT, sizeof(uint32_t));
+            fuzzy.bigramsTaken = (uint32_t *)Mem_Alloc(threadCount * fuzzy.bigramsRequired, sizeof(uint32_t));
+            for (int64_t index = 0; index + 1 < query->count; index++)
+            {
+                fuzzy.bigramCounts[StringList_Internal_FuzzyBigram(query->e + index)]++;
+            }
+            for (int32_t threadIndex = 1; threadIndex < threadCount; threadIndex++)
+            {
+                memcpy(fuzzy.bigramCounts + (int64_t)threadIndex * SCL_STRING_EDIT_BIGRAM_TABLE_COUNT, fuzzy.bigramCounts,
+                       SCL_STRING_EDIT_BIGRAM_TABLE_COUNT * sizeof(uint32_t));
+            }
+        }
+        
+        StringThreadPool_Run(pool, stringList->count, 0, StringList_Internal_FuzzyRange, &fuzzy);
+        
+        int64_t matchCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            matchCount += (fuzzy.distances[stringIndex] <= maxDistance);
+        }
+        if (matchCount > 0)
+        {
+            result.e = (StringFuzzyMatch *)Mem_Alloc(matchCount, sizeof(StringFuzzyMatch));
+            for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+            {
+                if (fuzzy.distances[stringIndex] <= maxDistance)
+                {
+                    result.e[result.count].index = stringIndex;
+                    result.e[result.count].distance = fuzzy.distances[stringIndex];
+                    result.count++;
+                }
+            }
+            qsort(result.e, result.count, sizeof(StringFuzzyMatch), StringList_Internal_CompareFuzzyMatches);
+        }
+        
+        Mem_Free(fuzzy.bigramsTaken);
+        Mem_Free(fuzzy.bigramCounts);
+        Mem_Free(fuzzy.scratch);
+        Mem_Free(fuzzy.distances);
+        Mem_Free(fuzzy.pattern.peq);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+
+// NOTE(s0lly): FileFollower functions
+
+#define SCL_STRING_FILE_FOLLOWER_BUFFER_COUNT (1 << 16)
+#define SCL_STRING_FILE_FOLLOWER_POLL_MS 250
+
+static int32_t FileFollower_Internal_Open(FileFollower *follower, int32_t isFromEnd)
+{
+    follower->isOpen = Platform_File_OpenRead(&follower->handle, (const char *)follower->filename.e);
+    if (follower->isOpen && !Platform_File_GetInfo(follower->handle, &follower->info))
+    {
+        Platform_File_Close(follower->handle);
+        follower->isOpen = 0;
+    }
+    follower->offset = (follower->isOpen && isFromEnd) ? follower->info.count : 0;
+    follower->partial.count = 0;
+    return follower->isOpen;
+}
+
+// NOTE(s0lly): Reads from offset up to the current end of the file, so the cost is only ever the new bytes
+static void FileFollower_Internal_ReadNew(FileFollower *follower, StringList *stringList)
+{
+    int64_t readCount = 0;
+    while ((readCount = Platform_File_ReadAt(follower->handle, follower->offset, follower->buffer, follower->bufferCountMax)) > 0)
+    {
+        StringList_Internal_PushLines(stringList, &follower->partial, follower->buffer, readCount);
+        follower->offset += readCount;
+    }
+    follower->partial.e[follower->partial.count] = '\0';
+}
+
+// NOTE(s0lly): Follows filename as it grows, in the manner of tail -F. isFromEnd skips the current contents. The file
+// doesn't need to exist yet. A zeroed FileFollower is returned only for a null filename.
+static FileFollower FileFollower_From_Filename_String(String *filename, int32_t isFromEnd)
+{
+    FileFollower result = { 0 };
+    
+    if (filename && filename->e)
+    {
+        result.filename = String_Internal_CopyStringIntoMessage(filename->e, filename->count, filename->count).string;
+        result.partial = String_From_CountMax(0).string;
+        result.bufferCountMax = SCL_STRING_FILE_FOLLOWER_BUFFER_COUNT;
+        result.buffer = (uint8_t *)Mem_Alloc(result.bufferCountMax, sizeof(uint8_t));
+        result.pollIntervalMs = SCL_STRING_FILE_FOLLOWER_POLL_MS;
+        
+        // NOTE(s0lly): The directory is watched rather than the file, so that a file created by rotation is seen too
+        int64_t separatorIndex = filename->count - 1;
+        while (separatorIndex >= 0 && filename->e[separatorIndex] != '/' && filename->e[separatorIndex] != '\\')
+        {
+            separatorIndex--;
+        }
+        if (separatorIndex < 0)
+        {
+            result.directory = String_From_CStr(".").string;
+        }
+        else
+        {
+            result.directory = String_Internal_CopyStringIntoMessage(filename->e, max(separatorIndex, 1), max(separatorIndex, 1)).string;
+        }
+        result.isWatching = Platform_Watch_Open(&result.watch, (const char *)result.directory.e);
+        
+        FileFollower_Internal_Open(&result, isFromEnd);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static FileFollower FileFollower_From_Filename_CStr(const char *cStr, int32_t isFromEnd)
+{
+    FileFollower result = { 0 };
+    
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = FileFollower_From_Filename_String(&filename, isFromEnd);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Returns the complete lines added since the last call, without waiting. A file that shrank is read again
+// from the start. When the path is renamed or deleted, the old file is read to its end (its unterminated last line
+// included), and then whatever file appears at the path is read from the start.
+static StringList FileFollower_Read(FileFollower *follower)
+{
+    StringList result = { 0 };
+    
+    if (follower && follower->filename.e)
+    {
+        if (follower->isOpen || FileFollower_Internal_Open(follower, 0))
+        {
+            Platform_FileInfo info = { 0 };
+            if (Platform_File_GetInfo(follower->handle, &info) && info.count < follower->offset)
+            {
+                follower->offset = 0;
+                follower->partial.count = 0;
+                follower->truncationCount++;
+            }
+            FileFollower_Internal_ReadNew(follower, &result);
+            
+            Platform_FileInfo pathInfo = { 0 };
+            int32_t isPathFound = Platform_File_GetInfo_Filename((const char *)follower->filename.e, &pathInfo);
+            if (!isPathFound || pathInfo.device != follower->info.device || pathInfo.id != follower->info.id)
+            {
+                if (follower->partial.count > 0)
+                {
+                    StringList_Internal_PushMove(&result, &follower->partial);
+                    follower->partial = String_From_CountMax(0).string;
+                }
+                Platform_File_Close(follower->handle);
+                follower->isOpen = 0;
+                follower->rotationCount++;
+                
+                if (isPathFound && FileFollower_Internal_Open(follower, 0))
+                {
+                    FileFollower_Internal_ReadNew(follower, &result);
+                }
+            }
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): As FileFollower_Read, but sleeps until at least one new line arrives or timeoutMs passes (a negative
+// timeoutMs waits indefinitely). Wakes on directory change notifications where available, and otherwise - or if a
+// notification is missed, as on network filesystems - looks again every pollIntervalMs.
+static StringList FileFollower_Wait(FileFollower *follower, int32_t timeoutMs)
+{
+    StringList result = FileFollower_Read(follower);
+    
+    if (follower && follower->filename.e)
+    {
+        int64_t timeEnd = Platform_TimeMs() + timeoutMs;
+        while (result.count == 0)
+        {
+            int64_t waitMs = max(follower->pollIntervalMs, 1);
+            if (timeoutMs >= 0)
+            {
+                waitMs = min(waitMs, timeEnd - Platform_TimeMs());
+                if (waitMs <= 0)
+                {
+                    break;
+                }
+            }
+            
+            if (follower->isWatching)
+            {
+                Platform_Watch_Wait(follower->watch, (int32_t)waitMs);
+            }
+            else
+            {
+                Platform_Sleep((int32_t)waitMs);
+            }
+            StringList_Destroy(&result);
+            result = FileFollower_Read(follower);
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static void FileFollower_Destroy(FileFollower *follower)
+{
+    if (follower)
+    {
+        if (follower->isOpen)
+        {
+            Platform_File_Close(follower->handle);
+        }
+        if (follower->isWatching)
+        {
+            Platform_Watch_Close(follower->watch);
+        }
+        String_Destroy(&follower->filename);
+        String_Destroy(&follower->directory);
+        String_Destroy(&follower->partial);
+        Mem_Free(follower->buffer);
+        Mem_ClearBytes(follower, sizeof(*follower));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+
+// NOTE(s0lly): StringPositions functions
+
+// NOTE(s0lly): Makes room for at least countNeeded offsets in total, doubling so that repeated pushes stay cheap
+static void StringPositions_Internal_Reserve(StringPositions *positions, int64_t countNeeded)
+{
+    if (countNeeded > positions->countMax)
+    {
+        int64_t countMaxNew = max(max(positions->countMax * 2, countNeeded), 16);
+        int64_t *eNew = (int64_t *)Mem_Alloc(countMaxNew, sizeof(int64_t));
+        if (positions->e)
+        {
+            SCL_STRING_STATS_REALLOC(positions->count * sizeof(int64_t));
+            memcpy(eNew, positions->e, positions->count * sizeof(int64_t));
+            Mem_Free(positions->e);
+        }
+        positions->e = eNew;
+        positions->countMax = countMaxNew;
+    }
+}
+
+static void StringPositions_Destroy(StringPositions *positions)
+{
+    if (positions)
+    {
+        Mem_Free(positions->e);
+        Mem_ClearBytes(positions, sizeof(*positions));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+
+// NOTE(s0lly): StringIndex functions
+
+#define SCL_STRING_INDEX_COUNT_MAX ((int64_t)INT32_MAX - 1)
+#define SCL_STRING_INDEX_VERSION 1
+
+static const uint8_t sclStringIndexMagic[8] = { 'S', 'C', 'L', 'S', 'I', 'D', 'X', '\0' };
+
+static inline int32_t StringIndex_Internal_Symbol(const uint8_t *text, const int32_t *names, int32_t index)
+{
+    return text ? (int32_t)text[index] : names[index];
+}
+
+// NOTE(s0lly): Places the sorted lms suffixes at the ends of their buckets, then induces the L suffixes left to right
+// and the S suffixes right to left
+static void StringIndex_Internal_Induce(const uint8_t *text, const int32_t *names, int32_t count, int32_t upper,
+                                        const uint8_t *isS, const int32_t *sumL, const int32_t *sumS,
+                                        const int32_t *lms, int32_t lmsCount, int32_t *suffixes, int32_t *buckets)
+{
+    for (int32_t index = 0; index < count; index++)
+    {
+        suffixes[index] = -1;
+    }
+    
+    memcpy(buckets, sumS, (upper + 2) * sizeof(int32_t));
+    for (int32_t lmsIndex = 0; lmsIndex < lmsCount; lmsIndex++)
+    {
+        int32_t suffix = lms[lmsIndex];
+        if (suffix != count)
+        {
+            suffixes[buckets[StringIndex_Internal_Symbol(text, names, suffix)]++] = suffix;
+        }
+    }
+    
+    memcpy(buckets, sumL, (upper + 2) * sizeof(int32_t));
+    suffixes[buckets[StringIndex_Internal_Symbol(text, names, count - 1)]++] = count - 1;
+    for (int32_t index = 0; index < count; index++)
+    {
+        int32_t suffix = suffixes[index];
+        if (suffix >= 1 && !isS[suffix - 1])
+        {
+            suffixes[buckets[StringIndex_Internal_Symbol(text, names, suffix - 1)]++] = suffix - 1;
+        }
+    }
+    
+    memcpy(buckets, sumL, (upper + 2) * sizeof(int32_t));
+    for (int32_t index = count - 1; index >= 0; index--)
+    {
+        int32_t suffix = suffixes[index];
+        if (suffix >= 1 && isS[suffix - 1])
+        {
+            suffixes[--buckets[StringIndex_Internal_Symbol(text, names, suffix - 1) + 1]] = suffix - 1;
+        }
+    }
+}
+
+// NOTE(s0lly): SA-IS (Nong, Zhang and Chan), in the formulation of the AtCoder Library. Sorts the suffixes of either
+// text (bytes) or, in the recursion, names (values in [0, upper]) in O(count) time.
+static void StringIndex_Internal_SuffixSort(const uint8_t *text, const int32_t *names, int32_t count, int32_t upper,
+                                            int32_t *suffixes)
+{
+    if (count <= 2)
+    {
+        if (count == 1)
+        {
+            suffixes[0] = 0;
+        }
+        else if (count == 2)
+        {
+            int32_t isFirstSmaller = (StringIndex_Internal_Symbol(text, names, 0) < StringIndex_Internal_Symbol(text, names, 1));
+            suffixes[0] = isFirstSmaller ? 0 : 1;
+            suffixes[1] = isFirstSmaller ? 1 : 0;
+        }
+        return;
+    }
+    
+    uint8_t *isS = (uint8_t *)Mem_Alloc(count, sizeof(uint8_t));
+    for (int32_t index = count - 2; index >= 0; index--)
+    {
+        int32_t symbol = StringIndex_Internal_Symbol(text, names, index);
+        int32_t symbolNext = StringIndex_Internal_Symbol(text, names, index + 1);
+        isS[index] = (symbol == symbolNext) ? isS[index + 1] : (uint8_t)(symbol < symbolNext);
+    }
+    
+    // NOTE(s0lly): sumS[c] is where the S suffixes starting with c begin, sumL[c] where the L suffixes do
+    int32_t *sumL = (int32_t *)Mem_Alloc(upper + 2, sizeof(int32_t));
+    int32_t *sumS = (int32_t *)Mem_Alloc(upper + 2, sizeof(int32_t));
+    int32_t *buckets = (int32_t *)Mem_Alloc(upper + 2, sizeof(int32_t));
+    for (int32_t index = 0; index < count; index++)
+    {
+        int32_t symbol = StringIndex_Internal_Symbol(text, names, index);
+        if (!isS[index])
+        {
+            sumS[symbol]++;
+        }
+        else
+        {
+            sumL[symbol + 1]++;
+        }
+    }
+    for (int32_t symbol = 0; symbol <= upper; symbol++)
+    {
+        sumS[symbol] += sumL[symbol];
+        if (symbol < upper)
+        {
+            sumL[symbol + 1] += sumS[symbol];
+        }
+    }
+    
+    int32_t *lmsMap = (int32_t *)Mem_Alloc((int64_t)count + 1, sizeof(int32_t));
+    int32_t lmsCount = 0;
+    for (int32_t index = 0; index <= count; index++)
+    {
+        lmsMap[index] = (index > 0 && index < count && !isS[index - 1] && isS[index]) ? lmsCount++ : -1;
+    }
+    int32_t *lms = (int32_t *)Mem_Alloc(max(lmsCount, 1), sizeof(int32_t));
+    for (int32_t index = 1; index < count; index++)
+    {
+        if (lmsMap[index] >= 0)
+        {
+            lms[lmsMap[index]] = index;
+        }
+    }
+    
+    StringIndex_Internal_Induce(text, names, count, upper, isS, sumL, sumS, lms, lmsCount, suffixes, buckets);
+    
+    if (lmsCount > 0)
+    {
+        // NOTE(s0lly): Name each lms substring by its rank among the distinct ones, and sort the lms suffixes by
+        // sorting the string of names
+        int32_t *sortedLms = (int32_t *)Mem_Alloc(lmsCount, sizeof(int32_t));
+        int32_t sortedCount = 0;
+        for (int32_t index = 0; index < count; index++)
+        {
+            if (lmsMap[suffixes[index]] >= 0)
+            {
+                sortedLms[sortedCount++] = suffixes[index];
+            }
+        }
+        
+        int32_t *recNames = (int32_t *)Mem_Alloc(lmsCount, sizeof(int32_t));
+        int32_t recUpper = 0;
+        for (int32_t lmsIndex = 1; lmsIndex < lmsCount; lmsIndex++)
+        {
+            int32_t left = sortedLms[lmsIndex - 1];
+            int32_t right = sortedLms[lmsIndex];
+            int32_t leftEnd = (lmsMap[left] + 1 < lmsCount) ? lms[lmsMap[left] + 1] : count;
+            int32_t rightEnd = (lmsMap[right] + 1 < lmsCount) ? lms[lmsMap[right] + 1] : count;
+            int32_t isSame = (leftEnd - left == rightEnd - right);
+            if (isSame)
+            {
+                while (left < leftEnd && StringIndex_Internal_Symbol(text, names, left) == StringIndex_Internal_Symbol(text, names, right))
+                {
+                    left++;
+                    right++;
+                }
+                isSame = (left < count && right < count
+                          && StringIndex_Internal_Symbol(text, names, left) == StringIndex_Internal_Symbol(text, names, right));
+            }
+            recUpper += !isSame;
+            recNames[lmsMap[sortedLms[lmsIndex]]] = recUpper;
+        }
+        
+        int32_t *recSuffixes = (int32_t *)Mem_Alloc(lmsCount, sizeof(int32_t));
+        StringIndex_Internal_SuffixSort(0, recNames, lmsCount, recUpper, recSuffixes);
+        for (int32_t lmsIndex = 0; lmsIndex < lmsCount; lmsIndex++)
+        {
+            sortedLms[lmsIndex] = lms[recSuffixes[lmsIndex]];
+        }
+        StringIndex_Internal_Induce(text, names, count, upper, isS, sumL, sumS, sortedLms, lmsCount, suffixes, buckets);
+        
+        Mem_Free(recSuffixes);
+        Mem_Free(recNames);
+        Mem_Free(sortedLms);
+    }
+    
+    Mem_Free(lms);
+    Mem_Free(lmsMap);
+    Mem_Free(buckets);
+    Mem_Free(sumS);
+    Mem_Free(sumL);
+    Mem_Free(isS);
+}
+
+// NOTE(s0lly): Kasai's algorithm - lcp[i] is the length of the prefix shared by the suffixes at i - 1 and i
+static void StringIndex_Internal_BuildLcp(StringIndex *index)
+{
+    int32_t *rank = (int32_t *)Mem_Alloc(max(index->count, 1), sizeof(int32_t));
+    for (int32_t suffixIndex = 0; suffixIndex < (int32_t)index->count; suffixIndex++)
+    {
+        rank[index->suffixes[suffixIndex]] = suffixIndex;
+    }
+    
+    int64_t shared = 0;
+    for (int64_t offset = 0; offset < index->count; offset++)
+    {
+        if (rank[offset] == 0)
+        {
+            shared = 0;
+            continue;
+        }
+        int64_t offsetPrevious = index->suffixes[rank[offset] - 1];
+        while (offset + shared < index->count && offsetPrevious + shared < index->count
+               && index->e[offset + shared] == index->e[offsetPrevious + shared])
+        {
+            shared++;
+        }
+        index->lcp[rank[offset]] = (int32_t)shared;
+        shared -= (shared > 0);
+    }
+    
+    Mem_Free(rank);
+}
+
+// NOTE(s0lly): Builds the index in O(count) time. The build needs up to about 20 bytes of memory per byte of text, and
+// the finished index keeps 8. The index holds its own reference to the text via String_From_String, so share a large
+// string first (String_Share) to avoid the copy. A zeroed StringIndex is returned on failure.
+static StringIndex StringIndex_From_String(String *string)
+{
+    StringIndex result = { 0 };
+    
+    if (string && string->e && string->count <= SCL_STRING_INDEX_COUNT_MAX)
+    {
+        result.text = String_From_String(string).string;
+        result.e = result.text.e;
+        result.count = result.text.count;
+        result.suffixes = (int32_t *)Mem_Alloc(max(result.count, 1), sizeof(int32_t));
+        result.lcp = (int32_t *)Mem_Alloc(max(result.count, 1), sizeof(int32_t));
+        StringIndex_Internal_SuffixSort(result.e, 0, (int32_t)result.count, 255, result.suffixes);
+        StringIndex_Internal_BuildLcp(&result);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static void StringIndex_Destroy(StringIndex *index)
+{
+    if (index)
+    {
+        if (index->mapping.data)
+        {
+            Platform_FileMapping_Close(&index->mapping);
+        }
+        else
+        {
+            Mem_Free(index->suffixes);
+            Mem_Free(index->lcp);
+            String_Destroy(&index->text);
+        }
+        Mem_ClearBytes(index, sizeof(*index));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): <0, 0 or >0 as the suffix at offset, cut to count bytes, sorts before, equal to or after data. Offsets
+// outside the text (only possible in an unverified file) compare as the empty suffix.
+static int32_t StringIndex_Internal_Compare(StringIndex *index, int64_t offset, const uint8_t *data, int64_t count)
+{
+    int64_t suffixCount = (offset >= 0 && offset < index->count) ? index->count - offset : 0;
+    int32_t result = (suffixCount > 0) ? memcmp(index->e + offset, data, (size_t)min(suffixCount, count)) : 0;
+    if (result == 0 && suffixCount < count)
+    {
+        result = -1;
+    }
+    return result;
+}
+
+// NOTE(s0lly): Two binary searches for the half-open range of suffixes starting with data - O(count log n)
+static void StringIndex_Internal_Range(StringIndex *index, const uint8_t *data, int64_t count,
+                                       int64_t *rangeStart, int64_t *rangeEnd)
+{
+    int64_t low = 0;
+    int64_t high = index->count;
+    while (low < high)
+    {
+        int64_t middle = low + (high - low) / 2;
+        if (StringIndex_Internal_Compare(index, index->suffixes[middle], data, count) < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    *rangeStart = low;
+    
+    high = index->count;
+    while (low < high)
+    {
+        int64_t middle = low + (high - low) / 2;
+        if (StringIndex_Internal_Compare(index, index->suffixes[middle], data, count) <= 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    *rangeEnd = low;
+}
+
+// NOTE(s0lly): int64Val holds the number of (possibly overlapping) occurrences of toFind
+static StringMessage StringIndex_Count(StringIndex *index, String *toFind)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index || !toFind)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->suffixes || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t rangeStart = 0;
+        int64_t rangeEnd = 0;
+        StringIndex_Internal_Range(index, toFind->e, toFind->count, &rangeStart, &rangeEnd);
+        msg.int64Val = rangeEnd - rangeStart;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Same results as String_Find_FirstFrom / String_Find_LastFrom on the indexed text. Locating the matches
+// is O(count log n); picking the first or last of them is a scan over the matches.
+static StringMessage StringIndex_Internal_Find(StringIndex *index, String *toFind, int64_t indexStart, int32_t isLast)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index || !toFind)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->suffixes || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (indexStart < 0 || indexStart >= index->count)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t rangeStart = 0;
+        int64_t rangeEnd = 0;
+        StringIndex_Internal_Range(index, toFind->e, toFind->count, &rangeStart, &rangeEnd);
+        
+        int64_t found = isLast ? -1 : index->count;
+        for (int64_t suffixIndex = rangeStart; suffixIndex < rangeEnd; suffixIndex++)
+        {
+            int64_t offset = index->suffixes[suffixIndex];
+            if (offset >= indexStart && (isLast ? offset > found : offset < found))
+            {
+                found = offset;
+            }
+        }
+        
+        if (found < 0 || found >= index->count)
+        {
+            msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
+        }
+        else
+        {
+            msg.int64Val = found;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage StringIndex_Find_FirstFrom(StringIndex *index, String *toFind, int64_t indexStart)
+{
+    StringMessage msg = StringIndex_Internal_Find(index, toFind, indexStart, 0);
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage StringIndex_Find_LastFrom(StringIndex *index, String *toFind, int64_t indexStart)
+{
+    StringMessage msg = StringIndex_Internal_Find(index, toFind, indexStart, 1);
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static int StringIndex_Internal_CompareOffsets(const void *a, const void *b)
+{
+    int64_t offsetA = *(const int64_t *)a;
+    int64_t offsetB = *(const int64_t *)b;
+    return (offsetA > offsetB) - (offsetA < offsetB);
+}
+
+// NOTE(s0lly): Appends the offset of every (possibly overlapping) occurrence of toFind to positions, in ascending order.
+// int64Val holds the number appended.
+static StringMessage StringIndex_Find_All(StringIndex *index, String *toFind, StringPositions *positions)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index || !toFind || !positions)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->suffixes || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t rangeStart = 0;
+        int64_t rangeEnd = 0;
+        StringIndex_Internal_Range(index, toFind->e, toFind->count, &rangeStart, &rangeEnd);
+        
+        if (rangeEnd > rangeStart)
+        {
+            StringPositions_Internal_Reserve(positions, positions->count + (rangeEnd - rangeStart));
+            int64_t *found = positions->e + positions->count;
+            for (int64_t suffixIndex = rangeStart; suffixIndex < rangeEnd; suffixIndex++)
+            {
+                found[suffixIndex - rangeStart] = index->suffixes[suffixIndex];
+            }
+            qsort(found, (size_t)(rangeEnd - rangeStart), sizeof(int64_t), StringIndex_Internal_CompareOffsets);
+            positions->count += rangeEnd - rangeStart;
+        }
+        msg.int64Val = rangeEnd - rangeStart;
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Returns a copy of the longest substring that occurs at least twice, read off the lcp array.
+// SCL_STRING_CODE__FIND_NO_MATCH if no byte repeats.
+static StringMessage StringIndex_Find_LongestRepeat(StringIndex *index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->suffixes)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        int64_t bestIndex = 0;
+        for (int64_t suffixIndex = 1; suffixIndex < index->count; suffixIndex++)
+        {
+            if (index->lcp[suffixIndex] > index->lcp[bestIndex])
+            {
+                bestIndex = suffixIndex;
+            }
+        }
+        
+        int64_t offset = index->suffixes[bestIndex];
+        if (index->lcp[bestIndex] <= 0 || offset < 0 || offset + index->lcp[bestIndex] > index->count)
+        {
+            msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
+        }
+        else
+        {
+            msg = String_Internal_CopyStringIntoMessage(index->e + offset, index->lcp[bestIndex], index->lcp[bestIndex]);
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static void StringIndex_Internal_Checksum(StringIndex *index, String_Internal_Checksum *checksum)
+{
+    String_Internal_Checksum_Init(checksum);
+    String_Internal_Checksum_Update(checksum, index->e, index->count);
+    String_Internal_Checksum_Update(checksum, (const uint8_t *)index->suffixes, index->count * sizeof(int32_t));
+    String_Internal_Checksum_Update(checksum, (const uint8_t *)index->lcp, index->count * sizeof(int32_t));
+}
+
+static StringMessage StringIndex_Save(StringIndex *index, String *filename)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    FILE *handle = 0;
+    
+    if (!index || !filename)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->suffixes || !filename->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (!(handle = fopen((const char *)filename->e, "wb")))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        StringIndexHeader header = { 0 };
+        memcpy(header.magic, sclStringIndexMagic, sizeof(header.magic));
+        header.version = SCL_STRING_INDEX_VERSION;
+        header.headerSize = sizeof(StringIndexHeader);
+        header.count = index->count;
+        
+        String_Internal_Checksum checksum = { 0 };
+        StringIndex_Internal_Checksum(index, &checksum);
+        header.checksum = String_Internal_Checksum_Final(&checksum);
+        
+        uint8_t padding[8] = { 0 };
+        size_t paddingCount = (size_t)((8 - index->count % 8) % 8);
+        int32_t writeOk = (fwrite(&header, sizeof(header), 1, handle) == 1);
+        writeOk = writeOk && (fwrite(index->e, 1, (size_t)index->count, handle) == (size_t)index->count);
+        writeOk = writeOk && (fwrite(padding, 1, paddingCount, handle) == paddingCount);
+        writeOk = writeOk && (fwrite(index->suffixes, sizeof(int32_t), (size_t)index->count, handle) == (size_t)index->count);
+        writeOk = writeOk && (fwrite(index->lcp, sizeof(int32_t), (size_t)index->count, handle) == (size_t)index->count);
+        if (fclose(handle) != 0 || !writeOk)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_FILE_WRITE;
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+static StringMessage StringIndex_Save_CStr(StringIndex *index, const char *cStr)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!cStr)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        String filename = String_From_CStr(cStr).string;
+        msg = StringIndex_Save(index, &filename);
+        String_Destroy(&filename);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Maps a saved index and checks only its header and size, so loading is immediate at any size. The text,
+// suffixes and lcp values are read straight from the mapping. Queries stay in bounds on a damaged file, but give
+// wrong answers - StringIndex_Verify checks the checksum. A zeroed StringIndex is returned on failure.
+static StringIndex StringIndex_Load(String *filename)
+{
+    StringIndex result = { 0 };
+    
+    if (filename && filename->e && Platform_FileMapping_Open(&result.mapping, (const char *)filename->e))
+    {
+        const StringIndexHeader *header = (const StringIndexHeader *)result.mapping.data;
+        int32_t valid = (result.mapping.count >= (int64_t)sizeof(StringIndexHeader)
+                         && memcmp(header->magic, sclStringIndexMagic, sizeof(header->magic)) == 0
+                         && header->version == SCL_STRING_INDEX_VERSION
+                         && header->headerSize == sizeof(StringIndexHeader)
+                         && header->count >= 0 && header->count <= SCL_STRING_INDEX_COUNT_MAX);
+        int64_t textCountPadded = valid ? (header->count + 7) & ~(int64_t)7 : 0;
+        valid = valid && (result.mapping.count == (int64_t)sizeof(StringIndexHeader) + textCountPadded
+                          + 2 * header->count * (int64_t)sizeof(int32_t));
+        
+        if (valid)
+        {
+            result.count = header->count;
+            result.e = result.mapping.data + sizeof(StringIndexHeader);
+            result.suffixes = (int32_t *)(result.mapping.data + sizeof(StringIndexHeader) + textCountPadded);
+            result.lcp = result.suffixes + result.count;
+        }
+        else
+        {
+            StringIndex_Destroy(&result);
+        }
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+static StringIndex StringIndex_Load_CStr(const char *cStr)
+{
+    StringIndex result = { 0 };
+    
+    if (cStr)
+    {
+        String filename = String_From_CStr(cStr).string;
+        result = StringIndex_Load(&filename);
+        String_Destroy(&filename);
+    }
+    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Reads the whole index to check a loaded file's checksum
+static StringMessage StringIndex_Verify(StringIndex *index)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!index)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!index->suffixes)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (index->mapping.data)
+    {
+        String_Internal_Checksum checksum = { 0 };
+        StringIndex_Internal_Checksum(index, &checksum);
+        if (String_Internal_Checksum_Final(&checksum) != ((const StringIndexHeader *)index->mapping.data)->checksum)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_INVALID_SNAPSHOT;
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+
+// NOTE(s0lly): Find all functions
+
+// NOTE(s0lly): With sse2 the compare results are summed in byte lanes, 64 bytes per step, and folded into 64 bit
+// totals with _mm_sad_epu8 every 63 steps, before a lane can overflow
+static int64_t String_Internal_CountByte(const uint8_t *data, int64_t count, uint8_t ch)
+{
+    int64_t result = 0;
+    int64_t index = 0;
+#if defined(SCL_STRING_SSE2)
+    __m128i target = _mm_set1_epi8((char)ch);
+    __m128i totals = _mm_setzero_si128();
+    while (index + 64 <= count)
+    {
+        __m128i lanes = _mm_setzero_si128();
+        int64_t indexEnd = min(count - 63, index + 63 * 64);
+        for (; index < indexEnd; index += 64)
+        {
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + index)), target));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + index + 16)), target));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + index + 32)), target));
+            lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + index + 48)), target));
+        }
+        totals = _mm_add_epi64(totals, _mm_sad_epu8(lanes, _mm_setzero_si128()));
+    }
+    int64_t laneTotals[2];
+    _mm_storeu_si128((__m128i *)laneTotals, totals);
+    result = laneTotals[0] + laneTotals[1];
+#endif
+    for (; index < count; index++)
+    {
+        result += (data[index] == ch);
+    }
+    return result;
+}
+
+static void String_Internal_FindAllByte(const uint8_t *data, int64_t count, uint8_t ch, StringPositions *positions)
+{
+    int64_t index = 0;
+#if defined(SCL_STRING_SSE2)
+    __m128i target = _mm_set1_epi8((char)ch);
+    for (; index + 16 <= count; index += 16)
+    {
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(data + index)), target));
+        if (mask)
+        {
+            StringPositions_Internal_Reserve(positions, positions->count + 16);
+            while (mask)
+            {
+                positions->e[positions->count++] = index + Platform_CountTrailingZeros32(mask);
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+    for (; index < count; index++)
+    {
+        if (data[index] == ch)
+        {
+            StringPositions_Internal_Reserve(positions, positions->count + 1);
+            positions->e[positions->count++] = index;
+        }
+    }
+}
+
+// NOTE(s0lly): One pass over data, resuming the byte search just after each match (or just after its end when
+// non-overlapping). Appends to positions unless it is null, and returns the number of matches.
+static int64_t String_Internal_FindAll(const uint8_t *data, int64_t count, const uint8_t *needle, int64_t needleCount,
+                                       SCL_STRING_FIND_MODE mode, StringPositions *positions)
+{
+    int64_t result = 0;
+    if (needleCount == 1)
+    {
+        if (positions)
+        {
+            int64_t countBefore = positions->count;
+            String_Internal_FindAllByte(data, count, needle[0], positions);
+            result = positions->count - countBefore;
+        }
+        else
+        {
+            result = String_Internal_CountByte(data, count, needle[0]);
+        }
+    }
+    else
+    {
+        int64_t step = (mode == SCL_STRING_FIND_MODE__NON_OVERLAPPING) ? needleCount : 1;
+        int64_t index = 0;
+        int64_t hitIndex = 0;
+        while (index <= count - needleCount && (hitIndex = String_Internal_FindBytes(data + index, count - index, needle, needleCount)) >= 0)
+        {
+            if (positions)
+            {
+                StringPositions_Internal_Reserve(positions, positions->count + 1);
+                positions->e[positions->count++] = index + hitIndex;
+            }
+            result++;
+            index += hitIndex + step;
+        }
+    }
+    return result;
+}
+
+// NOTE(s0lly): Appends the offset of every occurrence of toFind to positions, in ascending order, and sets int64Val to
+// the number appended. positions keeps its memory between calls, so setting its count to 0 reuses it without
+// allocating. A single byte toFind takes a vectorised path.
+static StringMessage String_Find_All(String *within, String *toFind, SCL_STRING_FIND_MODE mode, StringPositions *positions)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!within || !toFind || !positions)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!within->e || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (toFind->count <= 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        msg.int64Val = String_Internal_FindAll(within->e, within->count, toFind->e, toFind->count, mode, positions);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): int64Val holds the number of occurrences of toFind. Counting a single byte, such as newlines, runs at
+// close to memory bandwidth with sse2.
+static StringMessage String_Count_Occurrences(String *within, String *toFind, SCL_STRING_FIND_MODE mode)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!within || !toFind)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!within->e || !toFind->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (toFind->count <= 0)
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
     }
     else
     {
-        msg.chPtr = &string->e[index];
+        msg.int64Val = String_Internal_FindAll(within->e, within->count, toFind->e, toFind->count, mode, 0);
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_From_CountMax(int64_t countMax)
+
+// NOTE(s0lly): Hex and base64 functions
+
+static const uint8_t String_Internal_HexDigits[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+static const uint8_t String_Internal_Base64Digits[64] =
 {
-    StringMessage msg = { 0 };
-    if (countMax < 0)
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/',
+};
+
+// NOTE(s0lly): Makes room for appendCount more bytes at the end of the string, which the caller then writes in place
+static void String_Internal_ReserveAppend(String *string, int64_t appendCount)
+{
+    if (string->count + appendCount > string->countMax)
     {
-        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+        String_Resize(string, string->count + appendCount);
     }
     else
     {
-        msg.string.e = calloc(countMax + 1, sizeof(msg.string.e[0]));
-        msg.string.countMax = countMax;
+        String_Internal_Unshare(string);
     }
-    return msg;
 }
 
-static StringMessage String_Internal_CopyStringIntoMessage(const void *src, int64_t newCount, int64_t newCountMax)
+// NOTE(s0lly): As String_Internal_ReserveAppend, for appenders whose input is a raw pointer. If *data points into the
+// string's own contents, it is moved along with them, since reserving may reallocate or unshare the buffer.
+static void String_Internal_ReserveAppendFrom(String *string, int64_t appendCount, uint8_t **data)
 {
-    StringMessage msg = String_From_CountMax(newCountMax);
-    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    uintptr_t dataAddress = (uintptr_t)*data;
+    uintptr_t stringAddress = (uintptr_t)string->e;
+    int32_t isAliased = (dataAddress >= stringAddress && dataAddress < stringAddress + (uintptr_t)string->count);
+    String_Internal_ReserveAppend(string, appendCount);
+    if (isAliased)
     {
-        memmove(msg.string.e, src, newCount);
-        msg.string.count = newCount;
+        *data = string->e + (dataAddress - stringAddress);
     }
-    return msg;
 }
 
-static StringMessage String_From_CStr(const char *cStr)
+static int32_t String_Internal_Hex_Value(uint8_t ch)
 {
-    StringMessage msg = { 0 };
-    if (!cStr)
+    int32_t result = -1;
+    if (ch >= '0' && ch <= '9')
+    {
+        result = ch - '0';
+    }
+    else if ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f')
+    {
+        result = (ch | 0x20) - 'a' + 10;
+    }
+    return result;
+}
+
+static int32_t String_Internal_Base64_Value(uint8_t ch)
+{
+    int32_t result = -1;
+    if (ch >= 'A' && ch <= 'Z')
+    {
+        result = ch - 'A';
+    }
+    else if (ch >= 'a' && ch <= 'z')
+    {
+        result = ch - 'a' + 26;
+    }
+    else if (ch >= '0' && ch <= '9')
+    {
+        result = ch - '0' + 52;
+    }
+    else if (ch == '+')
+    {
+        result = 62;
+    }
+    else if (ch == '/')
+    {
+        result = 63;
+    }
+    return result;
+}
+
+// NOTE(s0lly): With sse2 each 16 input bytes are split into nibbles and turned into digits with a compare and add,
+// 32 digits per step
+static void String_Internal_Hex_Encode(const uint8_t *data, int64_t count, uint8_t *out)
+{
+    int64_t index = 0;
+#if defined(SCL_STRING_SSE2)
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i letterGap = _mm_set1_epi8('a' - '0' - 10);
+    for (; index + 16 <= count; index += 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(data + index));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), lowNibble);
+        __m128i low = _mm_and_si128(bytes, lowNibble);
+        high = _mm_add_epi8(_mm_add_epi8(high, zeroChar), _mm_and_si128(_mm_cmpgt_epi8(high, nine), letterGap));
+        low = _mm_add_epi8(_mm_add_epi8(low, zeroChar), _mm_and_si128(_mm_cmpgt_epi8(low, nine), letterGap));
+        _mm_storeu_si128((__m128i *)(out + index * 2), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i *)(out + index * 2 + 16), _mm_unpackhi_epi8(high, low));
+    }
+#endif
+    for (; index < count; index++)
+    {
+        out[index * 2] = String_Internal_HexDigits[data[index] >> 4];
+        out[index * 2 + 1] = String_Internal_HexDigits[data[index] & 0x0F];
+    }
+}
+
+// NOTE(s0lly): Returns the offset of the first invalid digit, or hexCount if all of them decoded.
+// The sse2 path turns 32 digits into nibbles with compares, checks them all at once, and joins pairs with shifts;
+// a block with any invalid digit is left to the scalar loop so that the exact offset is found.
+static int64_t String_Internal_Hex_Decode(const uint8_t *hex, int64_t hexCount, uint8_t *out)
+{
+    int64_t index = 0;
+#if defined(SCL_STRING_SSE2)
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i lowerA = _mm_set1_epi8('a');
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i minusOne = _mm_set1_epi8(-1);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i six = _mm_set1_epi8(6);
+    const __m128i lowByte = _mm_set1_epi16(0x00FF);
+    for (; index + 32 <= hexCount; index += 32)
+    {
+        __m128i nibbles[2];
+        int32_t validMask = 0xFFFF;
+        for (int32_t half = 0; half < 2; half++)
+        {
+            __m128i chars = _mm_loadu_si128((const __m128i *)(hex + index + half * 16));
+            __m128i digit = _mm_sub_epi8(chars, zeroChar);
+            __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, caseBit), lowerA);
+            __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(digit, minusOne), _mm_cmplt_epi8(digit, ten));
+            __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(letter, minusOne), _mm_cmplt_epi8(letter, six));
+            nibbles[half] = _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, ten)));
+            validMask &= _mm_movemask_epi8(_mm_or_si128(isDigit, isLetter));
+        }
+        if (validMask != 0xFFFF)
+        {
+            break;
+        }
+        for (int32_t half = 0; half < 2; half++)
+        {
+            nibbles[half] = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles[half], lowByte), 4), _mm_srli_epi16(nibbles[half], 8));
+        }
+        __m128i bytes = _mm_packus_epi16(nibbles[0], nibbles[1]);
+        _mm_storeu_si128((__m128i *)(out + index / 2), bytes);
+    }
+#endif
+    for (; index < hexCount; index += 2)
+    {
+        int32_t high = String_Internal_Hex_Value(hex[index]);
+        int32_t low = String_Internal_Hex_Value(hex[index + 1]);
+        if (high < 0 || low < 0)
+        {
+            return high < 0 ? index : index + 1;
+        }
+        out[index / 2] = (uint8_t)((high << 4) | low);
+    }
+    return hexCount;
+}
+
+// NOTE(s0lly): The ssse3 path is the pshufb method of W. Mula and D. Lemire: 12 input bytes are spread over 16
+// lanes of 6 bits with two multiplies, and the lane values are turned into characters with one table lookup
+static void String_Internal_Base64_Encode(const uint8_t *data, int64_t count, uint8_t *out)
+{
+    int64_t index = 0;
+    int64_t outIndex = 0;
+#if defined(SCL_STRING_SSSE3)
+    const __m128i spread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    for (; index + 16 <= count; index += 12, outIndex += 16)
+    {
+        __m128i bytes = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + index)), spread);
+        __m128i high = _mm_mulhi_epu16(_mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        __m128i low = _mm_mullo_epi16(_mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        __m128i values = _mm_or_si128(high, low);
+        __m128i range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+        range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i *)(out + outIndex), _mm_add_epi8(values, _mm_shuffle_epi8(offsets, range)));
+    }
+#endif
+    for (; index + 3 <= count; index += 3, outIndex += 4)
+    {
+        uint32_t triple = ((uint32_t)data[index] << 16) | ((uint32_t)data[index + 1] << 8) | data[index + 2];
+        out[outIndex] = String_Internal_Base64Digits[triple >> 18];
+        out[outIndex + 1] = String_Internal_Base64Digits[(triple >> 12) & 0x3F];
+        out[outIndex + 2] = String_Internal_Base64Digits[(triple >> 6) & 0x3F];
+        out[outIndex + 3] = String_Internal_Base64Digits[triple & 0x3F];
+    }
+    if (index < count)
+    {
+        uint32_t triple = ((uint32_t)data[index] << 16) | (index + 1 < count ? (uint32_t)data[index + 1] << 8 : 0);
+        out[outIndex] = String_Internal_Base64Digits[triple >> 18];
+        out[outIndex + 1] = String_Internal_Base64Digits[(triple >> 12) & 0x3F];
+        out[outIndex + 2] = index + 1 < count ? String_Internal_Base64Digits[(triple >> 6) & 0x3F] : '=';
+        out[outIndex + 3] = '=';
+    }
+}
+
+// NOTE(s0lly): Returns the offset of the first invalid character, or base64Count if all of it decoded.
+// Only canonical padded base64 is accepted: no whitespace, '=' only as the last one or two characters,
+// and the bits that a padded final group leaves over must be zero.
+// The ssse3 path classifies 16 characters by their nibbles with two pshufb lookups (W. Mula and D. Lemire),
+// and leaves the final group, which may be padded, and any block with an invalid character to the scalar loop.
+static int64_t String_Internal_Base64_Decode(const uint8_t *base64, int64_t base64Count, uint8_t *out)
+{
+    int64_t index = 0;
+    int64_t outIndex = 0;
+#if defined(SCL_STRING_SSSE3)
+    const __m128i lowLookup = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i highLookup = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i rollLookup = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i lowNibble = _mm_set1_epi8(0x0F);
+    const __m128i gather = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    for (; index + 16 <= base64Count - 4; index += 16, outIndex += 12)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i *)(base64 + index));
+        __m128i high = _mm_and_si128(_mm_srli_epi32(chars, 4), lowNibble);
+        __m128i classes = _mm_and_si128(_mm_shuffle_epi8(lowLookup, _mm_and_si128(chars, lowNibble)), _mm_shuffle_epi8(highLookup, high));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(classes, _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+        __m128i roll = _mm_shuffle_epi8(rollLookup, _mm_add_epi8(_mm_cmpeq_epi8(chars, _mm_set1_epi8('/')), high));
+        __m128i values = _mm_add_epi8(chars, roll);
+        __m128i joined = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        uint8_t block[16];
+        _mm_storeu_si128((__m128i *)block, _mm_shuffle_epi8(joined, gather));
+        memcpy(out + outIndex, block, 12);
+    }
+#endif
+    for (; index < base64Count; index += 4)
+    {
+        int32_t values[4];
+        int32_t padCount = 0;
+        if (index + 4 == base64Count)
+        {
+            padCount = (base64[index + 3] == '=') + (base64[index + 3] == '=' && base64[index + 2] == '=');
+        }
+        for (int32_t i = 0; i < 4 - padCount; i++)
+        {
+            values[i] = String_Internal_Base64_Value(base64[index + i]);
+            if (values[i] < 0)
+            {
+                return index + i;
+            }
+        }
+        if (padCount == 0)
+        {
+            uint32_t triple = ((uint32_t)values[0] << 18) | ((uint32_t)values[1] << 12) | ((uint32_t)values[2] << 6) | (uint32_t)values[3];
+            out[outIndex++] = (uint8_t)(triple >> 16);
+            out[outIndex++] = (uint8_t)(triple >> 8);
+            out[outIndex++] = (uint8_t)triple;
+        }
+        else if (padCount == 1)
+        {
+            if (values[2] & 0x03)
+            {
+                return index + 2;
+            }
+            out[outIndex++] = (uint8_t)((values[0] << 2) | (values[1] >> 4));
+            out[outIndex++] = (uint8_t)(((values[1] & 0x0F) << 4) | (values[2] >> 2));
+        }
+        else
+        {
+            if (values[1] & 0x0F)
+            {
+                return index + 1;
+            }
+            out[outIndex++] = (uint8_t)((values[0] << 2) | (values[1] >> 4));
+        }
+    }
+    return base64Count;
+}
+
+// NOTE(s0lly): Appends two lowercase hex digits per byte of data
+static StringMessage String_Append_Hex(String *string, uint8_t *data, int64_t count)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else
+    else if (!string->e || (!data && count > 0))
     {
-        msg = String_Internal_CopyStringIntoMessage((void *)cStr, strlen((const char *)cStr), strlen((const char *)cStr));
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (count < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else if (count > 0)
+    {
+        String_Internal_ReserveAppendFrom(string, count * 2, &data);
+        String_Internal_Hex_Encode(data, count, string->e + string->count);
+        string->count += count * 2;
+        string->e[string->count] = '\0';
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Destroy(String *string)
+// NOTE(s0lly): Appends standard base64 (the '+' '/' alphabet, padded with '=') of the data
+static StringMessage String_Append_Base64(String *string, uint8_t *data, int64_t count)
 {
-    StringMessage msg = { 0 };
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
     if (!string)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else
+    else if (!string->e || (!data && count > 0))
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else if (count < 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else if (count > 0)
     {
-        free(string->e);
-        *string = (String) { 0 };
+        int64_t encodedCount = (count + 2) / 3 * 4;
+        String_Internal_ReserveAppendFrom(string, encodedCount, &data);
+        String_Internal_Base64_Encode(data, count, string->e + string->count);
+        string->count += encodedCount;
+        string->e[string->count] = '\0';
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_From_String(String *src)
+// NOTE(s0lly): Appends the bytes that the hex digits stand for (either case). On invalid input the string is left
+// unchanged and int64Val holds the offset of the first invalid digit, or hexCount if the count is odd.
+static StringMessage String_Append_HexDecoded(String *string, uint8_t *hex, int64_t hexCount)
 {
-    StringMessage msg = { 0 };
-    if (!src)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if(!src->e)
+    else if (!string->e || (!hex && hexCount > 0))
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else
+    else if (hexCount < 0)
     {
-        msg = String_Internal_CopyStringIntoMessage(src->e, src->count, src->count);
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
+    }
+    else if (hexCount % 2 != 0)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_ENCODING;
+        msg.int64Val = hexCount;
+    }
+    else if (hexCount > 0)
+    {
+        String_Internal_ReserveAppendFrom(string, hexCount / 2, &hex);
+        int64_t invalidIndex = String_Internal_Hex_Decode(hex, hexCount, string->e + string->count);
+        if (invalidIndex < hexCount)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_INVALID_ENCODING;
+            msg.int64Val = invalidIndex;
+        }
+        else
+        {
+            string->count += hexCount / 2;
+        }
+        string->e[string->count] = '\0';
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_From_SubString(String *string, int64_t indexStartInclusive, int64_t indexEndInclusive)
+// NOTE(s0lly): Appends the bytes that the base64 stands for. On invalid input the string is left unchanged and
+// int64Val holds the offset of the first invalid character, or base64Count if the count is not a multiple of 4.
+static StringMessage String_Append_Base64Decoded(String *string, uint8_t *base64, int64_t base64Count)
 {
-    StringMessage msg = { 0 };
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
     if (!string)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if(!string->e)
+    else if (!string->e || (!base64 && base64Count > 0))
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (indexStartInclusive < 0 || indexStartInclusive >= string->count ||
-             indexEndInclusive < 0 || indexEndInclusive >= string->count ||
-             indexStartInclusive > indexEndInclusive)
+    else if (base64Count < 0)
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
     }
-    else 
+    else if (base64Count % 4 != 0)
     {
-        msg = String_Internal_CopyStringIntoMessage(string->e + indexStartInclusive,
-                                                    indexEndInclusive - indexStartInclusive + 1,
-                                                    indexEndInclusive - indexStartInclusive + 1);
-        
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_ENCODING;
+        msg.int64Val = base64Count;
+    }
+    else if (base64Count > 0)
+    {
+        int64_t padCount = (base64[base64Count - 1] == '=') + (base64[base64Count - 1] == '=' && base64[base64Count - 2] == '=');
+        int64_t decodedCount = base64Count / 4 * 3 - padCount;
+        String_Internal_ReserveAppendFrom(string, decodedCount, &base64);
+        int64_t invalidIndex = String_Internal_Base64_Decode(base64, base64Count, string->e + string->count);
+        if (invalidIndex < base64Count)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_INVALID_ENCODING;
+            msg.int64Val = invalidIndex;
+        }
+        else
+        {
+            string->count += decodedCount;
+        }
+        string->e[string->count] = '\0';
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_From_int64_t(int64_t val)
+// NOTE(s0lly): Escape functions
+
+// NOTE(s0lly): The bytes that end a run which can be copied as it is: any byte below controlEnd, and the four in chars
+typedef struct String_Internal_EscapeSet
 {
-    StringMessage msg = { 0 };
-    uint8_t tempValString[32];
-    int32_t tempCheck = sprintf((char *)tempValString, "%lld", val);
-    if (tempCheck < 0)
+    uint8_t chars[4];
+    uint8_t controlEnd;
+} String_Internal_EscapeSet;
+
+static String_Internal_EscapeSet String_Internal_EscapeSet_Get(SCL_STRING_ESCAPE_MODE mode, int32_t isUnescape)
+{
+    String_Internal_EscapeSet result = { 0 };
+    if (mode == SCL_STRING_ESCAPE_MODE__CSV)
     {
-        msg.code = SCL_STRING_CODE__ERROR_SPRINTF_CONVERTING_FROM_int64_t_TO_STRING;
+        memcpy(result.chars, isUnescape ? "\"\"\"\"" : ",\"\r\n", 4);
+    }
+    else if (mode == SCL_STRING_ESCAPE_MODE__JSON)
+    {
+        memcpy(result.chars, "\"\\\"\\", 4);
+        result.controlEnd = 0x20;
+    }
+    else if (isUnescape)
+    {
+        memcpy(result.chars, "\"\\\n\n", 4);
     }
     else
     {
-        msg = String_From_CStr((const char *)tempValString);
+        memcpy(result.chars, "\"\\\x7F\x7F", 4);
+        result.controlEnd = 0x20;
     }
-    return msg;
+    return result;
 }
 
-static StringMessage String_From_double(double val)
+// NOTE(s0lly): Returns the index of the first byte of the set at or after index, or count if there is none
+static int64_t String_Internal_Escape_FindNext(const uint8_t *data, int64_t index, int64_t count, String_Internal_EscapeSet *set)
 {
-    StringMessage msg = { 0 };
-    uint8_t tempValString[32];
-    int32_t tempCheck = sprintf((char *)tempValString, "%.16f", val);
-    if (tempCheck < 0)
+#if defined(SCL_STRING_SSE2)
+    __m128i char0 = _mm_set1_epi8((char)set->chars[0]);
+    __m128i char1 = _mm_set1_epi8((char)set->chars[1]);
+    __m128i char2 = _mm_set1_epi8((char)set->chars[2]);
+    __m128i char3 = _mm_set1_epi8((char)set->chars[3]);
+    __m128i controlMax = _mm_set1_epi8((char)(set->controlEnd - 1));
+    __m128i controlActive = _mm_set1_epi8(set->controlEnd ? -1 : 0);
+    for (; index + 16 <= count; index += 16)
+    {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(data + index));
+        __m128i isControl = _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(bytes, controlMax), bytes), controlActive);
+        __m128i isChar = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, char0), _mm_cmpeq_epi8(bytes, char1)),
+                                      _mm_or_si128(_mm_cmpeq_epi8(bytes, char2), _mm_cmpeq_epi8(bytes, char3)));
+        int32_t mask = _mm_movemask_epi8(_mm_or_si128(isControl, isChar));
+        if (mask)
+        {
+            return index + Platform_CountTrailingZeros32((uint32_t)mask);
+        }
+    }
+#endif
+    for (; index < count; index++)
     {
-        msg.code = SCL_STRING_CODE__ERROR_SPRINTF_CONVERTING_FROM_int64_t_TO_STRING;
+        uint8_t ch = data[index];
+        if (ch < set->controlEnd || ch == set->chars[0] || ch == set->chars[1] || ch == set->chars[2] || ch == set->chars[3])
+        {
+            break;
+        }
     }
-    else
+    return index;
+}
+
+// NOTE(s0lly): Writes the escaped form of one byte of the set to out, when out is not null, and returns its count.
+// C uses three digit octal for bytes without a short escape, so that a following digit can't extend the escape.
+static int64_t String_Internal_Escape_Sequence(uint8_t ch, SCL_STRING_ESCAPE_MODE mode, uint8_t *out)
+{
+    uint8_t sequence[6] = { '\\', ch };
+    int64_t sequenceCount = 2;
+    if (mode == SCL_STRING_ESCAPE_MODE__CSV)
     {
-        msg = String_From_CStr((const char *)tempValString);
+        sequence[0] = ch;
+        sequenceCount = (ch == '\"') ? 2 : 1;
     }
-    return msg;
+    else if (ch == '\b' || ch == '\f' || ch == '\n' || ch == '\r' || ch == '\t')
+    {
+        sequence[1] = (ch == '\b') ? 'b' : (ch == '\f') ? 'f' : (ch == '\n') ? 'n' : (ch == '\r') ? 'r' : 't';
+    }
+    else if (mode == SCL_STRING_ESCAPE_MODE__C && (ch == '\a' || ch == '\v'))
+    {
+        sequence[1] = (ch == '\a') ? 'a' : 'v';
+    }
+    else if (ch != '\"' && ch != '\\' && mode == SCL_STRING_ESCAPE_MODE__JSON)
+    {
+        memcpy(sequence + 1, "u00", 3);
+        sequence[4] = String_Internal_HexDigits[ch >> 4];
+        sequence[5] = String_Internal_HexDigits[ch & 0x0F];
+        sequenceCount = 6;
+    }
+    else if (ch != '\"' && ch != '\\')
+    {
+        sequence[1] = (uint8_t)('0' + (ch >> 6));
+        sequence[2] = (uint8_t)('0' + ((ch >> 3) & 7));
+        sequence[3] = (uint8_t)('0' + (ch & 7));
+        sequenceCount = 4;
+    }
+    if (out)
+    {
+        memcpy(out, sequence, sequenceCount);
+    }
+    return sequenceCount;
 }
 
-// TODO(s0lly): Flatten code
-static StringMessage String_From_FileNextLine(File *file)
+static int64_t String_Internal_Utf8_Encode(uint32_t codepoint, uint8_t *out)
 {
-    StringMessage msg = { 0 };
-    if (!file)
+    int64_t result = 0;
+    if (codepoint < 0x80)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_PASSED_TO_FUNCTION;
+        out[result++] = (uint8_t)codepoint;
     }
-    else if(!file->handle)
+    else if (codepoint < 0x800)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_FILE_HANDLE_PASSED_TO_FUNCTION;
+        out[result++] = (uint8_t)(0xC0 | (codepoint >> 6));
+        out[result++] = (uint8_t)(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+        out[result++] = (uint8_t)(0xE0 | (codepoint >> 12));
+        out[result++] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[result++] = (uint8_t)(0x80 | (codepoint & 0x3F));
     }
     else
     {
-        int64_t newSize = 256;
-        msg = String_From_CountMax(newSize);
-        
-        int32_t startCursor = file->cursor;
-        int32_t fseekCheck = fseek(file->handle, startCursor, SEEK_SET);
-        
-        uint8_t *fileScanResult = (uint8_t *)fgets((char *)msg.string.e, (uint32_t)msg.string.countMax, file->handle);
-        msg.string.count = strlen((const char *)msg.string.e);
-        if (fileScanResult == 0)
+        out[result++] = (uint8_t)(0xF0 | (codepoint >> 18));
+        out[result++] = (uint8_t)(0x80 | ((codepoint >> 12) & 0x3F));
+        out[result++] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[result++] = (uint8_t)(0x80 | (codepoint & 0x3F));
+    }
+    return result;
+}
+
+// NOTE(s0lly): Reads digitCount hex digits at data, returning -1 if any of them is missing or not a hex digit
+static int64_t String_Internal_Escape_ReadHex(const uint8_t *data, int64_t index, int64_t count, int64_t digitCount)
+{
+    int64_t result = 0;
+    for (int64_t digitIndex = 0; digitIndex < digitCount && result >= 0; digitIndex++)
+    {
+        int32_t digit = (index + digitIndex < count) ? String_Internal_Hex_Value(data[index + digitIndex]) : -1;
+        result = (digit < 0) ? -1 : (result << 4) | digit;
+    }
+    return result;
+}
+
+// NOTE(s0lly): Decodes the escape starting with the backslash at data[index], writing the bytes it stands for to out.
+// Returns the count of source bytes used, or 0 if the escape is invalid.
+static int64_t String_Internal_Unescape_Sequence(const uint8_t *data, int64_t index, int64_t count, SCL_STRING_ESCAPE_MODE mode,
+                                                 uint8_t *out, int64_t *outCount)
+{
+    int64_t result = 0;
+    uint8_t ch = (index + 1 < count) ? data[index + 1] : '\0';
+    const char *simple = (mode == SCL_STRING_ESCAPE_MODE__JSON) ? "\"\"\\\\//b\bf\fn\nr\rt\t" : "\"\"\\\\''??a\ab\bf\fn\nr\rt\tv\v";
+    const char *found = ch ? strchr(simple, ch) : 0;
+    *outCount = 0;
+    if (found && (found - simple) % 2 == 0)
+    {
+        out[(*outCount)++] = (uint8_t)found[1];
+        result = 2;
+    }
+    else if (mode == SCL_STRING_ESCAPE_MODE__JSON && ch == 'u')
+    {
+        int64_t codepoint = String_Internal_Escape_ReadHex(data, index + 2, count, 4);
+        result = 6;
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF)
         {
-            String_Destroy(&msg.string);
-            msg.code = SCL_STRING_CODE__FILE_ENCOUNTERED_EOF;
-            return msg;
+            int64_t low = (index + 7 < count && data[index + 6] == '\\' && data[index + 7] == 'u') ? String_Internal_Escape_ReadHex(data, index + 8, count, 4) : -1;
+            codepoint = (low >= 0xDC00 && low <= 0xDFFF) ? 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00) : -1;
+            result = 12;
         }
-        
-        int32_t endCursor = file->cursor + (int32_t)msg.string.count;
-        int32_t cursorDiff = endCursor - startCursor;
-        fseekCheck = fseek(file->handle, endCursor - 1, SEEK_SET);
-        int32_t isLineEnd = (int32_t)fgetc(file->handle);
-        int32_t isEOF = (int32_t)fgetc(file->handle);
-        while(!(isLineEnd == '\n') && !(isEOF == '\0' || isEOF == EOF))
+        if (codepoint < 0 || (codepoint >= 0xDC00 && codepoint <= 0xDFFF))
         {
-            fseekCheck = fseek(file->handle, startCursor, SEEK_SET);
-            newSize = msg.string.countMax * 2;
-            String_Destroy(&msg.string);
-            msg = String_From_CountMax(newSize);
-            fileScanResult = (uint8_t *)fgets((char *)msg.string.e, (int32_t)msg.string.countMax, file->handle);
-            msg.string.count = strlen((const char *)msg.string.e);
-            endCursor = file->cursor + (int32_t)msg.string.count;
-            cursorDiff = endCursor - startCursor;
-            fseekCheck = fseek(file->handle, endCursor - 1, SEEK_SET);
-            isLineEnd = (int32_t)fgetc(file->handle);
-            isEOF = (int32_t)fgetc(file->handle);
+            result = 0;
         }
-        
-        file->cursor += (int32_t)msg.string.count;
-        
-        if(*(String_Get_Last(&msg.string)).chPtr == '\n')
+        else
+        {
+            *outCount = String_Internal_Utf8_Encode((uint32_t)codepoint, out);
+        }
+    }
+    else if (mode == SCL_STRING_ESCAPE_MODE__C && ch >= '0' && ch <= '7')
+    {
+        int64_t value = 0;
+        for (result = 1; result < 4 && index + result < count && data[index + result] >= '0' && data[index + result] <= '7'; result++)
+        {
+            value = value * 8 + (data[index + result] - '0');
+        }
+        if (value > 0xFF)
+        {
+            result = 0;
+        }
+        else
         {
-            *(String_Get_Last(&msg.string)).chPtr = '\0';
-            msg.string.count--;
+            out[(*outCount)++] = (uint8_t)value;
         }
     }
-    
-    return msg;
-}
-
-static void String_Internal_ExtractStringFromMessage(String *dst, StringMessage* msg)
-{
-    *dst = msg->string;
-    msg->string = (String) { 0 };
-}
-
-static StringMessage String_Reinit_CountMax(String *string, int64_t countMax)
-{
-    StringMessage msg = String_Destroy(string);
-    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    else if (mode == SCL_STRING_ESCAPE_MODE__C && ch == 'x')
     {
-        msg = String_From_CountMax(countMax);
-        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        int64_t value = 0;
+        for (result = 2; index + result < count && value <= 0xFF && String_Internal_Hex_Value(data[index + result]) >= 0; result++)
         {
-            String_Internal_ExtractStringFromMessage(string, &msg);
+            value = value * 16 + String_Internal_Hex_Value(data[index + result]);
+        }
+        if (result == 2 || value > 0xFF)
+        {
+            result = 0;
+        }
+        else
+        {
+            out[(*outCount)++] = (uint8_t)value;
         }
     }
-    return msg;
-}
-
-static StringMessage String_Reinit_CStr(String *string, uint8_t *cStr)
-{
-    StringMessage msg = String_Destroy(string);
-    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    else if (mode == SCL_STRING_ESCAPE_MODE__C && (ch == 'u' || ch == 'U'))
     {
-        msg = String_From_CStr((const char *)cStr);
-        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        int64_t digitCount = (ch == 'u') ? 4 : 8;
+        int64_t codepoint = String_Internal_Escape_ReadHex(data, index + 2, count, digitCount);
+        result = 2 + digitCount;
+        if (codepoint < 0 || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF))
         {
-            String_Internal_ExtractStringFromMessage(string, &msg);
+            result = 0;
+        }
+        else
+        {
+            *outCount = String_Internal_Utf8_Encode((uint32_t)codepoint, out);
         }
     }
-    return msg;
+    return result;
 }
 
-static StringMessage String_Reinit_String(String *string, String *otherString)
+// NOTE(s0lly): Unescapes count bytes of data into out, which must have room for count bytes. Returns the offset of
+// the first invalid byte (count for a missing closing quote), or -1 if all of it was valid, and sets *outCount to the
+// count written.
+static int64_t String_Internal_Unescape(const uint8_t *data, int64_t count, SCL_STRING_ESCAPE_MODE mode, uint8_t *out, int64_t *outCount)
 {
-    StringMessage msg = String_Destroy(string);
-    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
-    {
-        msg = String_From_String(otherString);
-        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    String_Internal_EscapeSet set = String_Internal_EscapeSet_Get(mode, 1);
+    int64_t outIndex = 0;
+    int64_t index = 0;
+    int64_t indexEnd = count;
+    int64_t invalidIndex = -1;
+    int32_t isQuoted = (mode == SCL_STRING_ESCAPE_MODE__CSV && count > 0 && data[0] == '\"');
+    if (isQuoted)
+    {
+        if (count < 2 || data[count - 1] != '\"')
         {
-            String_Internal_ExtractStringFromMessage(string, &msg);
+            invalidIndex = count;
+            indexEnd = 0;
+        }
+        else
+        {
+            index = 1;
+            indexEnd = count - 1;
         }
     }
-    return msg;
-}
-
-static StringMessage String_Reinit_FileNextLine(String *string, File *file)
-{
-    StringMessage msg = String_Destroy(string);
-    if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+    while (index < indexEnd)
     {
-        msg = String_From_FileNextLine(file);
-        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        int64_t special = String_Internal_Escape_FindNext(data, index, indexEnd, &set);
+        memcpy(out + outIndex, data + index, special - index);
+        outIndex += special - index;
+        index = special;
+        if (index < indexEnd)
         {
-            String_Internal_ExtractStringFromMessage(string, &msg);
+            int64_t sequenceCount = 0;
+            int64_t decodedCount = 0;
+            if (mode == SCL_STRING_ESCAPE_MODE__CSV)
+            {
+                sequenceCount = (isQuoted && index + 1 < indexEnd && data[index + 1] == '\"') ? 2 : 0;
+                out[outIndex] = '\"';
+                decodedCount = 1;
+            }
+            else if (data[index] == '\\')
+            {
+                sequenceCount = String_Internal_Unescape_Sequence(data, index, indexEnd, mode, out + outIndex, &decodedCount);
+            }
+            if (sequenceCount == 0)
+            {
+                invalidIndex = index;
+                break;
+            }
+            outIndex += decodedCount;
+            index += sequenceCount;
         }
     }
-    return msg;
+    *outCount = outIndex;
+    return invalidIndex;
 }
 
-static StringMessage String_Clear(String *string)
+// NOTE(s0lly): Appends the escaped form of source to string, allocating at most once (source may be string itself).
+// CSV quotes the field, doubling its quotes, only when it holds a comma, quote, carriage return or line feed.
+// JSON and C escape the contents of a string literal, without adding the surrounding quotes: quotes, backslashes
+// and control bytes are escaped, and other bytes, including UTF-8, are copied as they are.
+static StringMessage String_Escape(String *string, String *source, SCL_STRING_ESCAPE_MODE mode)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !source)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if(!string->e)
+    else if (!string->e || !source->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
     else
     {
-        Mem_ClearBytes(string->e, string->countMax * sizeof(string->e[0]));
-        string->count = 0;
+        String_Internal_EscapeSet set = String_Internal_EscapeSet_Get(mode, 0);
+        int64_t sourceCount = source->count;
+        int64_t escapedCount = sourceCount;
+        int64_t specialCount = 0;
+        for (int64_t index = String_Internal_Escape_FindNext(source->e, 0, sourceCount, &set); index < sourceCount;
+             index = String_Internal_Escape_FindNext(source->e, index + 1, sourceCount, &set))
+        {
+            escapedCount += String_Internal_Escape_Sequence(source->e[index], mode, 0) - 1;
+            specialCount++;
+        }
+        int32_t isQuoted = (mode == SCL_STRING_ESCAPE_MODE__CSV && specialCount > 0);
+        escapedCount += isQuoted * 2;
+        
+        String_Internal_ReserveAppend(string, escapedCount);
+        const uint8_t *data = source->e;
+        uint8_t *out = string->e + string->count;
+        int64_t runStart = 0;
+        if (isQuoted)
+        {
+            *out++ = '\"';
+        }
+        for (int64_t index = specialCount ? String_Internal_Escape_FindNext(data, 0, sourceCount, &set) : sourceCount; index < sourceCount;
+             index = String_Internal_Escape_FindNext(data, index + 1, sourceCount, &set))
+        {
+            memcpy(out, data + runStart, index - runStart);
+            out += index - runStart;
+            out += String_Internal_Escape_Sequence(data[index], mode, out);
+            runStart = index + 1;
+        }
+        memcpy(out, data + runStart, sourceCount - runStart);
+        out += sourceCount - runStart;
+        if (isQuoted)
+        {
+            *out++ = '\"';
+        }
+        string->count += escapedCount;
+        string->e[string->count] = '\0';
+        msg.int64Val = escapedCount;
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Resize(String *string, int64_t newCountMax)
+// NOTE(s0lly): Appends the unescaped form of source to string, allocating at most once (source may be string itself).
+// CSV takes one field, quoted or not. JSON and C take the contents of a string literal without its quotes; \u escapes
+// (and \U and \x in C) are written as UTF-8, and JSON surrogate pairs are joined. On invalid input the string is left
+// unchanged and int64Val holds the offset of the first invalid byte, or the count for a missing closing quote.
+static StringMessage String_Unescape(String *string, String *source, SCL_STRING_ESCAPE_MODE mode)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !source)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if (newCountMax < 0)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e)
+    else if (!string->e || !source->e)
     {
-        msg = String_Reinit_CountMax(string, newCountMax);
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (newCountMax <= string->countMax)
+    else
     {
-        string->countMax = newCountMax;
-        string->count = min(string->count, string->countMax);
+        int64_t sourceCount = source->count;
+        int64_t unescapedCount = 0;
+        String_Internal_ReserveAppend(string, sourceCount);
+        int64_t invalidIndex = String_Internal_Unescape(source->e, sourceCount, mode, string->e + string->count, &unescapedCount);
+        if (invalidIndex >= 0)
+        {
+            msg.code = SCL_STRING_CODE__ERROR_INVALID_ENCODING;
+            msg.int64Val = invalidIndex;
+        }
+        else
+        {
+            string->count += unescapedCount;
+            msg.int64Val = unescapedCount;
+        }
         string->e[string->count] = '\0';
     }
-    else
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Column conversion functions
+
+static const double String_Internal_PowersOf10[23] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+typedef struct StringList_Internal_ColumnContext
+{
+    StringList *stringList;
+    int64_t indexStart;
+    int64_t stride;
+    int64_t *int64Values;
+    double *doubleValues;
+    uint8_t *validBits;
+    int64_t *firstInvalid;
+    
+} StringList_Internal_ColumnContext;
+
+// NOTE(s0lly): Reads the run of decimal digits at data[index], eight at a time where eight bytes remain (SWAR: the
+// digits are checked and combined pairwise within one 64 bit word), accumulating them into *value.
+// Returns the index after the run. *value wraps past 19 digits, which the callers check for with the digit count.
+static int64_t String_Internal_Parse_Digits(const uint8_t *data, int64_t index, int64_t count, uint64_t *value)
+{
+    uint64_t result = *value;
+    while (index + 8 <= count)
+    {
+        uint64_t chunk;
+        memcpy(&chunk, data + index, 8);
+        uint64_t isDigits = ((chunk & 0xF0F0F0F0F0F0F0F0ull) == 0x3030303030303030ull)
+            && (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) == 0x3030303030303030ull);
+        if (!isDigits)
+        {
+            break;
+        }
+        chunk = ((chunk & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+        chunk = ((chunk & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+        chunk = ((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+        result = result * 100000000 + chunk;
+        index += 8;
+    }
+    while (index < count && data[index] >= '0' && data[index] <= '9')
     {
-        msg = String_Internal_CopyStringIntoMessage(string->e, string->count, newCountMax);
-        String_Destroy(string);
-        String_Internal_ExtractStringFromMessage(string, &msg);
+        result = result * 10 + (data[index] - '0');
+        index++;
     }
-    return msg;
+    *value = result;
+    return index;
 }
 
-static StringMessage String_IsEmpty(String *string)
+// NOTE(s0lly): Accepts an optional sign followed by one or more decimal digits, and nothing else
+static int32_t String_Internal_Parse_int64(const uint8_t *data, int64_t count, int64_t *value)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    int64_t index = (count > 0 && (data[0] == '-' || data[0] == '+'));
+    int32_t isNegative = (index == 1 && data[0] == '-');
+    while (index + 1 < count && data[index] == '0')
+    {
+        index++;
+    }
+    uint64_t magnitude = 0;
+    int64_t digitStart = index;
+    index = String_Internal_Parse_Digits(data, index, count, &magnitude);
+    int32_t result = (index == count && index > digitStart && index - digitStart <= 19
+                      && magnitude <= (uint64_t)INT64_MAX + (uint64_t)isNegative);
+    *value = result ? (isNegative ? (int64_t)(0 - magnitude) : (int64_t)magnitude) : 0;
+    return result;
+}
+
+// NOTE(s0lly): Accepts [sign] digits [. digits] [e|E [sign] digits] with at least one mantissa digit - no whitespace,
+// hex, inf or nan. When the mantissa fits in 53 bits and the power of ten is at most 22, both are exact doubles and
+// one multiply or divide gives the correctly rounded result (Clinger's fast path); anything else goes to strtod.
+static int32_t String_Internal_Parse_double(const uint8_t *data, int64_t count, double *value)
+{
+    int64_t signCount = (count > 0 && (data[0] == '-' || data[0] == '+'));
+    int32_t isNegative = (signCount == 1 && data[0] == '-');
+    int64_t index = signCount;
+    while (index < count && data[index] == '0')
+    {
+        index++;
+    }
+    int32_t hasDigits = (index > signCount);
+    uint64_t mantissa = 0;
+    int64_t integerStart = index;
+    index = String_Internal_Parse_Digits(data, index, count, &mantissa);
+    int64_t significantCount = index - integerStart;
+    int64_t exponent10 = 0;
+    hasDigits |= (significantCount > 0);
+    if (index < count && data[index] == '.')
+    {
+        index++;
+        int64_t fractionStart = index;
+        if (significantCount == 0)
+        {
+            while (index < count && data[index] == '0')
+            {
+                index++;
+            }
+        }
+        int64_t fractionDigitStart = index;
+        index = String_Internal_Parse_Digits(data, index, count, &mantissa);
+        significantCount += index - fractionDigitStart;
+        exponent10 -= index - fractionStart;
+        hasDigits |= (index > fractionStart);
+    }
+    int32_t result = hasDigits;
+    if (result && index < count && (data[index] == 'e' || data[index] == 'E'))
+    {
+        index++;
+        int32_t isExponentNegative = (index < count && data[index] == '-');
+        index += (index < count && (data[index] == '-' || data[index] == '+'));
+        int64_t exponentStart = index;
+        int64_t exponent = 0;
+        while (index < count && data[index] >= '0' && data[index] <= '9')
+        {
+            exponent = min(exponent * 10 + (data[index] - '0'), 100000);
+            index++;
+        }
+        result = (index > exponentStart);
+        exponent10 += isExponentNegative ? -exponent : exponent;
+    }
+    result = result && (index == count);
+    
+    *value = 0.0;
+    if (result && significantCount <= 19 && mantissa <= (1ull << 53) && exponent10 >= -22 && exponent10 <= 22)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+        double magnitude = (double)mantissa;
+        magnitude = (exponent10 < 0) ? magnitude / String_Internal_PowersOf10[-exponent10] : magnitude * String_Internal_PowersOf10[exponent10];
+        *value = isNegative ? -magnitude : magnitude;
     }
-    else if (!string->e)
+    else if (result && data[count] == '\0')
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        *value = strtod((const char *)data, 0);
     }
-    else
+    else if (result)
     {
-        msg.int64Val = (int64_t)(string->count == 0);
+        uint8_t *copy = (uint8_t *)Mem_Alloc(count + 1, sizeof(uint8_t));
+        memcpy(copy, data, count);
+        *value = strtod((const char *)copy, 0);
+        Mem_Free(copy);
     }
-    return msg;
+    return result;
 }
 
-static StringMessage String_Insert_Generic(String *string, uint8_t *otherData, int64_t index, int64_t otherCount)
+// NOTE(s0lly): Ranges start at multiples of 8 (see StringList_Internal_ToArray), so each validity byte is written whole
+// by one worker
+static void StringList_Internal_ColumnRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    StringList_Internal_ColumnContext *column = (StringList_Internal_ColumnContext *)context;
+    uint8_t validByte = 0;
+    for (int64_t index = indexStart; index < indexEnd; index++)
+    {
+        String *string = &column->stringList->e[column->indexStart + index * column->stride];
+        int32_t isValid = 0;
+        if (string->e && column->int64Values)
+        {
+            isValid = String_Internal_Parse_int64(string->e, string->count, &column->int64Values[index]);
+        }
+        else if (string->e)
+        {
+            isValid = String_Internal_Parse_double(string->e, string->count, &column->doubleValues[index]);
+        }
+        else if (column->int64Values)
+        {
+            column->int64Values[index] = 0;
+        }
+        else
+        {
+            column->doubleValues[index] = 0.0;
+        }
+        
+        if (!isValid && index < column->firstInvalid[workerIndex])
+        {
+            column->firstInvalid[workerIndex] = index;
+        }
+        validByte |= (uint8_t)(isValid << (index & 7));
+        if (column->validBits && ((index & 7) == 7 || index + 1 == indexEnd))
+        {
+            column->validBits[index >> 3] = validByte;
+            validByte = 0;
+        }
+    }
+}
+
+static StringMessage StringList_Internal_ToArray(StringThreadPool *pool, StringList *stringList, int64_t indexStart, int64_t stride,
+                                                 int64_t *int64Values, double *doubleValues, uint8_t *validBits)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!stringList)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if(!string->e)
+    else if (!int64Values && !doubleValues)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (index < 0 || index > string->count)
+    else if (indexStart < 0 || indexStart > stringList->count)
     {
         msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
     }
-    else if (otherCount <= 0)
+    else if (stride <= 0)
     {
         msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
     }
-    else if (string->count + otherCount > string->countMax)
-    {
-        msg = String_From_CountMax(string->count + otherCount);
-        memmove(msg.string.e, string->e, index);
-        memmove(msg.string.e + index, otherData, otherCount);
-        memmove(msg.string.e + index + otherCount, string->e + index, string->count - index);
-        msg.string.count = msg.string.countMax;
-        String_Destroy(string);
-        String_Internal_ExtractStringFromMessage(string, &msg);
-    }
     else
     {
-        memmove(string->e + index + otherCount, string->e + index, string->count - index);
-        memmove(string->e + index, otherData, otherCount);
-        string->count += otherCount;
+        int64_t count = (stringList->count - indexStart + stride - 1) / stride;
+        int32_t threadCount = StringThreadPool_Get_ThreadCount(pool);
+        StringList_Internal_ColumnContext column = { 0 };
+        column.stringList = stringList;
+        column.indexStart = indexStart;
+        column.stride = stride;
+        column.int64Values = int64Values;
+        column.doubleValues = doubleValues;
+        column.validBits = validBits;
+        column.firstInvalid = (int64_t *)Mem_Alloc(threadCount, sizeof(int64_t));
+        for (int32_t threadIndex = 0; threadIndex < threadCount; threadIndex++)
+        {
+            column.firstInvalid[threadIndex] = count;
+        }
+        
+        int64_t chunkCount = (max(count / ((int64_t)threadCount * 8), 4096) + 7) & ~(int64_t)7;
+        StringThreadPool_Run(pool, count, chunkCount, StringList_Internal_ColumnRange, &column);
+        
+        msg.int64Val = count;
+        for (int32_t threadIndex = 0; threadIndex < threadCount; threadIndex++)
+        {
+            if (column.firstInvalid[threadIndex] < msg.int64Val)
+            {
+                msg.int64Val = column.firstInvalid[threadIndex];
+            }
+        }
+        if (msg.int64Val < count)
+        {
+            msg.code = int64Values ? SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_int64_t : SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_double;
+        }
+        Mem_Free(column.firstInvalid);
     }
     return msg;
 }
 
-static StringMessage String_Insert_CStr(String *string, uint8_t *cStr, int64_t index)
+// NOTE(s0lly): Converts elements indexStart, indexStart + stride, ... of the list, e.g. one column of rows that were
+// split into stride fields each, into values[0], values[1], ... - (count - indexStart + stride - 1) / stride of them.
+// Bit i of validBits (least significant bit first, may be null) is set when element i converted, and an element
+// that didn't becomes 0. On success int64Val holds the number of values written, otherwise the code is
+// SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_int64_t and int64Val is the first invalid index.
+// The text is an optional sign and decimal digits only: unlike int64_t_From_String, '+' and leading zeros are
+// allowed. The list is split between the pool's workers (null runs serially).
+static StringMessage StringList_To_int64_Array_Strided(StringThreadPool *pool, StringList *stringList, int64_t indexStart, int64_t stride,
+                                                       int64_t *values, uint8_t *validBits)
 {
-    StringMessage msg = { 0 };
-    if (!cStr)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else
-    {
-        msg = String_Insert_Generic(string, cStr, index, strlen((const char *)cStr));
-    }
+    StringMessage msg = StringList_Internal_ToArray(pool, stringList, indexStart, stride, values, 0, validBits);
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Insert_uint8_t(String *string, uint8_t ch, int64_t index)
+// NOTE(s0lly): As StringList_To_int64_Array_Strided, for decimal text such as -12.5e3 (no whitespace, inf or nan).
+// Results are correctly rounded.
+static StringMessage StringList_To_double_Array_Strided(StringThreadPool *pool, StringList *stringList, int64_t indexStart, int64_t stride,
+                                                        double *values, uint8_t *validBits)
 {
-    StringMessage msg = { 0 };
-    if (ch == '\0')
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_CHARACTER_PASSED_TO_FUNCTION;
-    }
-    else
-    {
-        msg = String_Insert_Generic(string, &ch, index, 1);
-    }
+    StringMessage msg = StringList_Internal_ToArray(pool, stringList, indexStart, stride, 0, values, validBits);
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Insert_String(String *string, String *otherString, int64_t index)
+static StringMessage StringList_To_int64_Array(StringThreadPool *pool, StringList *stringList, int64_t *values, uint8_t *validBits)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if(!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else
-    {
-        msg = String_Insert_Generic(string, otherString->e, index, otherString->count);
-    }
+    StringMessage msg = StringList_To_int64_Array_Strided(pool, stringList, 0, 1, values, validBits);
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Append_Generic(String *string, uint8_t *otherData, int64_t otherCount)
+static StringMessage StringList_To_double_Array(StringThreadPool *pool, StringList *stringList, double *values, uint8_t *validBits)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if(!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else
-    {
-        msg = String_Insert_Generic(string, otherData, string->count, otherCount);
-    }
+    StringMessage msg = StringList_To_double_Array_Strided(pool, stringList, 0, 1, values, validBits);
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Append_CStr(String *string, uint8_t *cStr)
+// NOTE(s0lly): Memory usage functions
+
+#define SCL_STRING_PACKED_HEADER_COUNT (2 * (int64_t)sizeof(int64_t))
+
+typedef struct StringList_Internal_UsageEntry
 {
-    StringMessage msg = { 0 };
-    if (!cStr)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else
+    const void *key;
+    int64_t blockBytes;
+    int64_t liveBytes;
+    
+} StringList_Internal_UsageEntry;
+
+// NOTE(s0lly): Size of the allocation behind a shared String
+static int64_t String_Internal_SharedAllocationBytes(String *string)
+{
+    return String_Internal_IsPacked(string) ? string->refCount[1] : (int64_t)((uint8_t *)string->refCount - string->e) + (int64_t)sizeof(int64_t);
+}
+
+// NOTE(s0lly): Open addressing on the pointer value - returns the entry for key, claiming an empty one if it is new
+static StringList_Internal_UsageEntry *StringList_Internal_UsageFind(StringList_Internal_UsageEntry *entries, int64_t entryMask,
+                                                                     const void *key, int32_t *isNew)
+{
+    uint64_t slot = ((uint64_t)(uintptr_t)key >> 3) * 0x9E3779B97F4A7C15ull;
+    slot >>= 32;
+    while (entries[slot & entryMask].key && entries[slot & entryMask].key != key)
     {
-        msg = String_Append_Generic(string, cStr, strlen((const char *)cStr));
+        slot++;
     }
-    return msg;
+    StringList_Internal_UsageEntry *entry = &entries[slot & entryMask];
+    *isNew = (entry->key == 0);
+    entry->key = key;
+    return entry;
 }
 
-static StringMessage String_Append_uint8_t(String *string, uint8_t ch)
+// NOTE(s0lly): A String with its own buffer reports count + 1 live bytes and countMax - count slack. A shared buffer is
+// also held by other Strings, so for a lone String only its live bytes are reported, and under sharedBytes too.
+static StringMemoryUsage String_MemoryUsage(String *string)
 {
-    StringMessage msg = { 0 };
-    if (ch == '\0')
+    StringMemoryUsage result = { 0 };
+    if (string && string->e)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_CHARACTER_PASSED_TO_FUNCTION;
+        result.liveBytes = string->count + 1;
+        if (string->refCount)
+        {
+            result.sharedBytes = result.liveBytes;
+        }
+        else
+        {
+            result.slackBytes = string->countMax - string->count;
+            result.allocationCount = 1;
+        }
     }
-    else
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Adds up the header array and every element. Each shared buffer or packed block that the elements refer
+// to is counted once, with the bytes that no element of the list uses as slack.
+static StringMemoryUsage StringList_MemoryUsage(StringList *stringList)
+{
+    StringMemoryUsage result = { 0 };
+    if (stringList && stringList->e)
     {
-        msg = String_Append_Generic(string, &ch, 1);
+        result.liveBytes = stringList->count * (int64_t)sizeof(String);
+        result.slackBytes = (stringList->countMax - stringList->count) * (int64_t)sizeof(String);
+        result.allocationCount = 1;
+        
+        int64_t sharedCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+        {
+            String *string = &stringList->e[stringIndex];
+            if (string->e && !string->refCount)
+            {
+                result.liveBytes += string->count + 1;
+                result.slackBytes += string->countMax - string->count;
+                result.allocationCount++;
+            }
+            sharedCount += (string->e && string->refCount);
+        }
+        
+        if (sharedCount > 0)
+        {
+            int64_t entryCount = 16;
+            while (entryCount < sharedCount * 4)
+            {
+                entryCount *= 2;
+            }
+            StringList_Internal_UsageEntry *entries = (StringList_Internal_UsageEntry *)Mem_Alloc(entryCount, sizeof(StringList_Internal_UsageEntry));
+            for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+            {
+                String *string = &stringList->e[stringIndex];
+                int32_t isNew = 0;
+                if (string->e && string->refCount)
+                {
+                    StringList_Internal_UsageFind(entries, entryCount - 1, string->e, &isNew);
+                }
+                if (isNew)
+                {
+                    StringList_Internal_UsageEntry *block = StringList_Internal_UsageFind(entries, entryCount - 1, (const void *)string->refCount, &isNew);
+                    if (isNew)
+                    {
+                        block->blockBytes = String_Internal_SharedAllocationBytes(string);
+                        result.allocationCount++;
+                    }
+                    block->liveBytes += string->count + 1;
+                    result.liveBytes += string->count + 1;
+                    result.sharedBytes += string->count + 1;
+                }
+            }
+            for (int64_t entryIndex = 0; entryIndex < entryCount; entryIndex++)
+            {
+                result.slackBytes += max(entries[entryIndex].blockBytes - entries[entryIndex].liveBytes, 0);
+            }
+            Mem_Free(entries);
+        }
     }
-    return msg;
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
 }
 
-static StringMessage String_Append_String(String *string, String *otherString)
+// NOTE(s0lly): Moves a string with slack into a buffer of exactly count + 1 bytes. Shared strings are left as they are.
+// int64Val holds the number of bytes given back.
+static StringMessage String_Compact(String *string)
 {
-    StringMessage msg = { 0 };
-    if (!otherString)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if(!otherString->e)
+    else if (!string->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else
+    else if (!string->refCount && string->countMax > string->count)
     {
-        msg = String_Append_Generic(string, otherString->e, otherString->count);
+        msg.int64Val = string->countMax - string->count;
+        uint8_t *eNew = (uint8_t *)Mem_Alloc(string->count + 1, sizeof(uint8_t));
+        memcpy(eNew, string->e, string->count);
+        SCL_STRING_STATS_REALLOC(string->count);
+        Mem_Free(string->e);
+        string->e = eNew;
+        string->countMax = string->count;
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Compare(String *stringA, String *stringB)
+// NOTE(s0lly): Trims the header array and every element to its count. With isContiguous, the data of all elements is
+// instead copied into one packed block, a single allocation with no slack that the elements share: modifying an
+// element then gives it a buffer of its own, and the block is freed with the last element still in it.
+// int64Val holds the number of bytes given back (negative if packing shared buffers made copies of them).
+static StringMessage StringList_Compact(StringList *stringList, int32_t isContiguous)
 {
-    StringMessage msg = { 0 };
-    if (!stringA || !stringB)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!stringList)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if(!stringA->e || !stringB->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else
+    else if (stringList->e)
     {
-        int32_t compVal = strcmp((const char *)stringA->e, (const char *)stringB->e);
-        if (compVal == 0)
+        StringMemoryUsage usageBefore = StringList_MemoryUsage(stringList);
+        if (stringList->countMax > stringList->count)
         {
-            msg.code = SCL_STRING_CODE__COMPARE_EQUAL;
+            StringList_Resize(stringList, stringList->count);
         }
-        else if(compVal < 0)
+        
+        int64_t blockBytes = SCL_STRING_PACKED_HEADER_COUNT;
+        int64_t packedCount = 0;
+        for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
         {
-            msg.code = SCL_STRING_CODE__COMPARE_LESS_THAN;
+            String *string = &stringList->e[stringIndex];
+            if (string->e && isContiguous)
+            {
+                blockBytes += string->count + 1;
+                packedCount++;
+            }
+            else if (string->e)
+            {
+                String_Compact(string);
+            }
         }
-        else
+        
+        if (packedCount > 0)
         {
-            msg.code = SCL_STRING_CODE__COMPARE_GREATER_THAN;
+            uint8_t *block = (uint8_t *)Mem_Alloc(blockBytes, sizeof(uint8_t));
+            volatile int64_t *header = (volatile int64_t *)block;
+            header[0] = packedCount;
+            header[1] = blockBytes;
+            uint8_t *cursor = block + SCL_STRING_PACKED_HEADER_COUNT;
+            SCL_STRING_STATS_REALLOC(blockBytes);
+            for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
+            {
+                String *string = &stringList->e[stringIndex];
+                if (string->e)
+                {
+                    memcpy(cursor, string->e, string->count);
+                    String_Internal_Release(string);
+                    string->e = cursor;
+                    string->countMax = string->count;
+                    string->refCount = header;
+                    cursor += string->count + 1;
+                }
+            }
         }
+        
+        StringMemoryUsage usageAfter = StringList_MemoryUsage(stringList);
+        msg.int64Val = (usageBefore.liveBytes + usageBefore.slackBytes) - (usageAfter.liveBytes + usageAfter.slackBytes);
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage int64_t_From_String(String *string)
+// NOTE(s0lly): Diff functions
+
+typedef struct StringList_Internal_DiffContext
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    // NOTE(s0lly): Line ids of the lines that occur in both lists, and where they came from
+    int32_t *idsA;
+    int32_t *idsB;
+    int64_t *indicesA;
+    int64_t *indicesB;
+    
+    // NOTE(s0lly): Furthest reaching paths of the forward and reverse searches
+    int64_t *forward;
+    int64_t *backward;
+    
+    // NOTE(s0lly): Runs of matched lines as (indexA, indexB, count) triples, in order
+    int64_t *matches;
+    int64_t matchCount;
+    int64_t matchCountMax;
+    
+} StringList_Internal_DiffContext;
+
+// NOTE(s0lly): 64 bit hash of a line or token, eight bytes per multiply
+static uint64_t String_Internal_HashBytes(const uint8_t *data, int64_t count)
+{
+    uint64_t result = SCL_STRING_CHECKSUM_PRIME_3 ^ ((uint64_t)count * SCL_STRING_CHECKSUM_PRIME_1);
+    int64_t index = 0;
+    for (; index + 8 <= count; index += 8)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+        uint64_t word;
+        memcpy(&word, data + index, 8);
+        result = String_Internal_Checksum_Rotate(result ^ (word * SCL_STRING_CHECKSUM_PRIME_2), 31) * SCL_STRING_CHECKSUM_PRIME_1;
     }
-    else if (!string->e)
+    if (index < count)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        uint64_t word = 0;
+        memcpy(&word, data + index, count - index);
+        result = String_Internal_Checksum_Rotate(result ^ (word * SCL_STRING_CHECKSUM_PRIME_2), 31) * SCL_STRING_CHECKSUM_PRIME_1;
     }
-    else
+    result ^= result >> 33;
+    result *= SCL_STRING_CHECKSUM_PRIME_2;
+    result ^= result >> 29;
+    return result;
+}
+
+static int32_t StringList_Internal_DiffLinesEqual(String *lineA, String *lineB)
+{
+    int64_t countA = lineA->e ? lineA->count : 0;
+    int64_t countB = lineB->e ? lineB->count : 0;
+    return countA == countB && (countA == 0 || memcmp(lineA->e, lineB->e, countA) == 0);
+}
+
+static void StringList_Internal_DiffPushMatch(StringList_Internal_DiffContext *diff, int64_t indexA, int64_t indexB, int64_t count)
+{
+    if (count > 0)
     {
-        msg.int64Val = atoi((const char *)string->e);
-        StringMessage tempIntValString = String_From_CountMax(string->count);
-        sprintf((char *)tempIntValString.string.e, "%lld", msg.int64Val);
-        if (String_Compare(&tempIntValString.string, string).code == SCL_STRING_CODE__COMPARE_EQUAL)
-        {
-            msg.code = SCL_STRING_CODE__NO_MESSAGE;
-        }
-        else
+        if (diff->matchCount + 3 > diff->matchCountMax)
         {
-            msg.code = SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_int64_t;
+            int64_t matchCountMaxNew = max(diff->matchCountMax * 2, 48);
+            int64_t *matchesNew = (int64_t *)Mem_Alloc(matchCountMaxNew, sizeof(int64_t));
+            if (diff->matches)
+            {
+                SCL_STRING_STATS_REALLOC(diff->matchCount * sizeof(int64_t));
+                memcpy(matchesNew, diff->matches, diff->matchCount * sizeof(int64_t));
+                Mem_Free(diff->matches);
+            }
+            diff->matches = matchesNew;
+            diff->matchCountMax = matchCountMaxNew;
         }
-        String_Destroy(&tempIntValString.string);
+        diff->matches[diff->matchCount++] = indexA;
+        diff->matches[diff->matchCount++] = indexB;
+        diff->matches[diff->matchCount++] = count;
     }
-    return msg;
 }
 
-// TODO(s0lly): Reorder elses
-static StringMessage double_From_String(String *string)
+// NOTE(s0lly): Finds the middle snake of the shortest edit script between idsA[aStart, aEnd) and idsB[bStart, bEnd) by
+// running Myers' search forwards and backwards at once, in linear space. Returns 0 if the two ranges share no line.
+static int32_t StringList_Internal_DiffBisect(StringList_Internal_DiffContext *diff, int64_t aStart, int64_t aEnd, int64_t bStart, int64_t bEnd,
+                                              int64_t *splitA, int64_t *splitB)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e)
+    const int32_t *a = diff->idsA + aStart;
+    const int32_t *b = diff->idsB + bStart;
+    int64_t countA = aEnd - aStart;
+    int64_t countB = bEnd - bStart;
+    int64_t dMax = (countA + countB + 1) / 2;
+    int64_t vOffset = dMax;
+    int64_t *forward = diff->forward;
+    int64_t *backward = diff->backward;
+    
+    // NOTE(s0lly): Only diagonals within d + 1 of the middle are read at step d, so they are cleared as the search
+    // widens rather than all at once
+    for (int64_t vIndex = vOffset - 1; vIndex <= vOffset + 1; vIndex++)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        forward[vIndex] = -1;
+        backward[vIndex] = -1;
     }
-    else
-    {
-        msg.doubleVal = atof((const char *)string->e);
-        
-        int32_t encounteredDot = 0;
-        int32_t countDots = 0;
-        int32_t countNumsBeforeDot = 0;
-        int32_t countNumsAfterDot = 0;
-        int32_t encounteredMinusFirst = 0;
-        int32_t countMinus = 0;
-        int32_t countOther = 0;
+    forward[vOffset + 1] = 0;
+    backward[vOffset + 1] = 0;
+    
+    int64_t delta = countA - countB;
+    int32_t isFrontOverlap = (delta % 2 != 0);
+    int64_t kForwardStart = 0;
+    int64_t kForwardEnd = 0;
+    int64_t kBackwardStart = 0;
+    int64_t kBackwardEnd = 0;
+    for (int64_t d = 0; d < dMax; d++)
+    {
+        if (d > 0)
+        {
+            forward[vOffset - d - 1] = -1;
+            forward[vOffset + d + 1] = -1;
+            backward[vOffset - d - 1] = -1;
+            backward[vOffset + d + 1] = -1;
+        }
         
-        int64_t segmentIndex = 0;
-        while (segmentIndex < string->count)
+        for (int64_t k = -d + kForwardStart; k <= d - kForwardEnd; k += 2)
         {
-            uint8_t currentChar = string->e[segmentIndex];
-            if (currentChar == '.')
+            int64_t kIndex = vOffset + k;
+            int64_t x = (k == -d || (k != d && forward[kIndex - 1] < forward[kIndex + 1])) ? forward[kIndex + 1] : forward[kIndex - 1] + 1;
+            int64_t y = x - k;
+            while (x < countA && y < countB && a[x] == b[y])
             {
-                countDots++;
-                encounteredDot = 1;
+                x++;
+                y++;
             }
-            else if (currentChar >= '0' && currentChar <= '9')
+            forward[kIndex] = x;
+            if (x > countA)
             {
-                if (encounteredDot == 0)
-                {
-                    countNumsBeforeDot++;
-                }
-                else
-                {
-                    countNumsAfterDot++;
-                }
+                kForwardEnd += 2;
             }
-            else if (currentChar == '-')
+            else if (y > countB)
             {
-                countMinus++;
-                if (segmentIndex == 0)
-                {
-                    encounteredMinusFirst = 1;
-                }
+                kForwardStart += 2;
             }
-            else
+            else if (isFrontOverlap)
             {
-                countOther++;
+                int64_t kBackwardIndex = vOffset + delta - k;
+                if (kBackwardIndex >= vOffset - d - 1 && kBackwardIndex <= vOffset + d + 1 && backward[kBackwardIndex] != -1 && x >= countA - backward[kBackwardIndex])
+                {
+                    *splitA = aStart + x;
+                    *splitB = bStart + y;
+                    return 1;
+                }
             }
-            
-            segmentIndex++;
         }
         
-        if (!(countDots == 1 && countOther == 0 &&
-              countNumsBeforeDot >= 0 && countNumsAfterDot >= 0 &&
-              countNumsBeforeDot + countNumsAfterDot > 0 &&
-              ((countMinus == 0 && !encounteredMinusFirst) || (countMinus == 1 && encounteredMinusFirst))))
-            // Must be in format [dddd].[dddd] i.e. numbers either or both before and after '.',
-            //     but at least one numeric value somewhere
+        for (int64_t k = -d + kBackwardStart; k <= d - kBackwardEnd; k += 2)
         {
-            msg.code = SCL_STRING_CODE__ERROR_CANT_CONVERT_STRING_TO_double;
+            int64_t kIndex = vOffset + k;
+            int64_t x = (k == -d || (k != d && backward[kIndex - 1] < backward[kIndex + 1])) ? backward[kIndex + 1] : backward[kIndex - 1] + 1;
+            int64_t y = x - k;
+            while (x < countA && y < countB && a[countA - x - 1] == b[countB - y - 1])
+            {
+                x++;
+                y++;
+            }
+            backward[kIndex] = x;
+            if (x > countA)
+            {
+                kBackwardEnd += 2;
+            }
+            else if (y > countB)
+            {
+                kBackwardStart += 2;
+            }
+            else if (!isFrontOverlap)
+            {
+                int64_t kForwardIndex = vOffset + delta - k;
+                if (kForwardIndex >= vOffset - d - 1 && kForwardIndex <= vOffset + d + 1 && forward[kForwardIndex] != -1)
+                {
+                    int64_t xForward = forward[kForwardIndex];
+                    if (xForward >= countA - x)
+                    {
+                        *splitA = aStart + xForward;
+                        *splitB = bStart + (vOffset + xForward - kForwardIndex);
+                        return 1;
+                    }
+                }
+            }
         }
     }
-    return msg;
+    return 0;
 }
 
-static StringMessage String_Remove(String *string, int64_t indexStartInclusive, int64_t indexEndInclusive)
+// NOTE(s0lly): Records the matched lines of idsA[aStart, aEnd) and idsB[bStart, bEnd) in order: the common prefix and
+// suffix directly, and the middle by splitting it at its middle snake
+static void StringList_Internal_DiffCompare(StringList_Internal_DiffContext *diff, int64_t aStart, int64_t aEnd, int64_t bStart, int64_t bEnd)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e)
+    int64_t prefixCount = 0;
+    while (aStart + prefixCount < aEnd && bStart + prefixCount < bEnd && diff->idsA[aStart + prefixCount] == diff->idsB[bStart + prefixCount])
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        prefixCount++;
     }
-    else if (indexStartInclusive < 0 || indexStartInclusive >= string->count ||
-             indexEndInclusive < 0 || indexEndInclusive >= string->count ||
-             indexStartInclusive > indexEndInclusive)
+    StringList_Internal_DiffPushMatch(diff, aStart, bStart, prefixCount);
+    aStart += prefixCount;
+    bStart += prefixCount;
+    
+    int64_t suffixCount = 0;
+    while (aEnd - suffixCount > aStart && bEnd - suffixCount > bStart && diff->idsA[aEnd - suffixCount - 1] == diff->idsB[bEnd - suffixCount - 1])
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        suffixCount++;
     }
-    else
+    aEnd -= suffixCount;
+    bEnd -= suffixCount;
+    
+    int64_t splitA = 0;
+    int64_t splitB = 0;
+    if (aStart < aEnd && bStart < bEnd && StringList_Internal_DiffBisect(diff, aStart, aEnd, bStart, bEnd, &splitA, &splitB))
     {
-        int64_t originalCount = string->count;
-        memmove(string->e + indexStartInclusive, string->e + indexEndInclusive + 1, string->count - (indexEndInclusive + 1));
-        string->count = string->count - (indexEndInclusive - indexStartInclusive + 1);
-        Mem_ClearBytes(string->e + string->count, originalCount - string->count);
+        StringList_Internal_DiffCompare(diff, aStart, splitA, bStart, splitB);
+        StringList_Internal_DiffCompare(diff, splitA, aEnd, splitB, bEnd);
     }
-    return msg;
+    StringList_Internal_DiffPushMatch(diff, aEnd, bEnd, suffixCount);
 }
 
-static StringMessage String_Remove_WhitespacePrecending(String *string)
+static void StringDiff_Internal_PushEdit(StringDiff *result, StringList *listB, int64_t indexA, int64_t countA, int64_t indexB, int64_t countB)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else
+    if (countA > 0 || countB > 0)
     {
-        int64_t indexFirstNonWhitespace = -1;
-        for (int64_t strIndex = 0; strIndex < string->count; strIndex++)
+        if (result->count >= result->countMax)
         {
-            if (*String_Get(string, strIndex).chPtr != ' ')
+            int64_t countMaxNew = max(result->countMax * 2, 16);
+            StringDiffEdit *eNew = (StringDiffEdit *)Mem_Alloc(countMaxNew, sizeof(StringDiffEdit));
+            if (result->e)
             {
-                indexFirstNonWhitespace = strIndex;
-                break;
+                SCL_STRING_STATS_REALLOC(result->count * sizeof(StringDiffEdit));
+                memcpy(eNew, result->e, result->count * sizeof(StringDiffEdit));
+                Mem_Free(result->e);
             }
+            result->e = eNew;
+            result->countMax = countMaxNew;
         }
-        
-        if (indexFirstNonWhitespace > 0)
-        {
-            memmove(string->e, string->e + indexFirstNonWhitespace, string->count - indexFirstNonWhitespace);
-            int64_t originalCount = string->count;
-            string->count = string->count - indexFirstNonWhitespace;
-            Mem_ClearBytes(string->e + string->count, originalCount - string->count);
-        }
-        else if (indexFirstNonWhitespace == -1)
+        StringDiffEdit *edit = &result->e[result->count++];
+        edit->indexA = indexA;
+        edit->countA = countA;
+        edit->indexB = indexB;
+        edit->countB = countB;
+        for (int64_t lineIndex = indexB; lineIndex < indexB + countB; lineIndex++)
         {
-            int64_t originalCount = string->count;
-            string->count = 0;
-            Mem_ClearBytes(string->e, originalCount);
+            StringList_PushCopy(&result->lines, &listB->e[lineIndex]);
         }
     }
-    return msg;
 }
 
-static StringMessage String_Remove_WhitespaceFollowing(String *string)
+static void StringDiff_Destroy(StringDiff *diff)
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e)
+    if (diff)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        Mem_Free(diff->e);
+        StringList_Destroy(&diff->lines);
+        Mem_ClearBytes(diff, sizeof(*diff));
     }
-    else
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
+
+// NOTE(s0lly): Line diff from listA to listB as a minimal edit script (Myers' algorithm). The common prefix and suffix
+// are trimmed first; every other line is hashed and given an id, comparing two lines in full only when their hashes are
+// equal, and lines that occur in just one of the lists are set aside as edits before the search, which then runs on
+// ids alone. A diff with no edits has count 0.
+static StringDiff StringList_Diff(StringList *listA, StringList *listB)
+{
+    StringDiff result = { 0 };
+    if (listA && listB)
     {
-        int64_t indexLastNonWhitespace = -1;
-        for (int64_t strIndex = string->count - 1; strIndex >= 0; strIndex--)
+        int64_t countA = listA->e ? listA->count : 0;
+        int64_t countB = listB->e ? listB->count : 0;
+        int64_t prefixCount = 0;
+        while (prefixCount < countA && prefixCount < countB && StringList_Internal_DiffLinesEqual(&listA->e[prefixCount], &listB->e[prefixCount]))
+        {
+            prefixCount++;
+        }
+        int64_t suffixCount = 0;
+        while (suffixCount < countA - prefixCount && suffixCount < countB - prefixCount
+               && StringList_Internal_DiffLinesEqual(&listA->e[countA - suffixCount - 1], &listB->e[countB - suffixCount - 1]))
+        {
+            suffixCount++;
+        }
+        int64_t middleCountA = countA - prefixCount - suffixCount;
+        int64_t middleCountB = countB - prefixCount - suffixCount;
+        
+        StringList_Internal_DiffContext diff = { 0 };
+        if (middleCountA > 0 && middleCountB > 0)
         {
-            if (*String_Get(string, strIndex).chPtr != ' ')
+            // NOTE(s0lly): Line ids from an open addressing table of the distinct lines, with per-list occurrence flags.
+            // Each slot holds the top half of its line's hash next to the id, so that a probe only leaves the table
+            // for a full comparison when the whole hash matches, and the lines are hashed up front so that the slots
+            // can be prefetched ahead of use.
+            int64_t middleCount = middleCountA + middleCountB;
+            int64_t slotCount = 16;
+            while (slotCount < middleCount + middleCount / 2)
             {
-                indexLastNonWhitespace = strIndex;
-                break;
+                slotCount *= 2;
+            }
+            uint64_t *lineHashes = (uint64_t *)Mem_Alloc(middleCount, sizeof(uint64_t));
+            for (int64_t lineIndex = 0; lineIndex < middleCount; lineIndex++)
+            {
+                String *line = (lineIndex < middleCountA) ? &listA->e[prefixCount + lineIndex] : &listB->e[prefixCount + lineIndex - middleCountA];
+                lineHashes[lineIndex] = String_Internal_HashBytes(line->e, line->e ? line->count : 0);
+            }
+            
+            uint64_t *slots = (uint64_t *)Mem_Alloc(slotCount, sizeof(uint64_t));
+            int64_t *uniqueLines = (int64_t *)Mem_Alloc(middleCount, sizeof(int64_t));
+            uint8_t *uniqueSides = (uint8_t *)Mem_Alloc(middleCount, sizeof(uint8_t));
+            int32_t *lineIds = (int32_t *)Mem_Alloc(middleCount, sizeof(int32_t));
+            int32_t uniqueCount = 0;
+            for (int64_t lineIndex = 0; lineIndex < middleCount; lineIndex++)
+            {
+#if defined(SCL_STRING_SSE2)
+                if (lineIndex + 16 < middleCount)
+                {
+                    _mm_prefetch((const char *)&slots[lineHashes[lineIndex + 16] & (slotCount - 1)], _MM_HINT_T0);
+                }
+#endif
+                int32_t isB = (lineIndex >= middleCountA);
+                String *line = isB ? &listB->e[prefixCount + lineIndex - middleCountA] : &listA->e[prefixCount + lineIndex];
+                uint64_t hash = lineHashes[lineIndex];
+                uint64_t tag = hash & 0xFFFFFFFF00000000ull;
+                uint64_t slot = hash;
+                int32_t id = -1;
+                while (slots[slot & (slotCount - 1)])
+                {
+                    uint64_t entry = slots[slot & (slotCount - 1)];
+                    int32_t candidate = (int32_t)(entry & 0xFFFFFFFF) - 1;
+                    if ((entry & 0xFFFFFFFF00000000ull) == tag && lineHashes[uniqueLines[candidate]] == hash)
+                    {
+                        int64_t candidateIndex = uniqueLines[candidate];
+                        String *candidateLine = (candidateIndex < middleCountA) ? &listA->e[prefixCount + candidateIndex]
+                            : &listB->e[prefixCount + candidateIndex - middleCountA];
+                        if (StringList_Internal_DiffLinesEqual(candidateLine, line))
+                        {
+                            id = candidate;
+                            break;
+                        }
+                    }
+                    slot++;
+                }
+                if (id < 0)
+                {
+                    id = uniqueCount++;
+                    uniqueLines[id] = lineIndex;
+                    slots[slot & (slotCount - 1)] = tag | (uint64_t)(id + 1);
+                }
+                uniqueSides[id] |= (uint8_t)(1 << isB);
+                lineIds[lineIndex] = id;
+            }
+            
+            diff.idsA = (int32_t *)Mem_Alloc(middleCountA, sizeof(int32_t));
+            diff.idsB = (int32_t *)Mem_Alloc(middleCountB, sizeof(int32_t));
+            diff.indicesA = (int64_t *)Mem_Alloc(middleCountA, sizeof(int64_t));
+            diff.indicesB = (int64_t *)Mem_Alloc(middleCountB, sizeof(int64_t));
+            int64_t keptCountA = 0;
+            int64_t keptCountB = 0;
+            for (int64_t lineIndex = 0; lineIndex < middleCount; lineIndex++)
+            {
+                int32_t id = lineIds[lineIndex];
+                if (uniqueSides[id] == 3 && lineIndex < middleCountA)
+                {
+                    diff.idsA[keptCountA] = id;
+                    diff.indicesA[keptCountA++] = prefixCount + lineIndex;
+                }
+                else if (uniqueSides[id] == 3)
+                {
+                    diff.idsB[keptCountB] = id;
+                    diff.indicesB[keptCountB++] = prefixCount + lineIndex - middleCountA;
+                }
+            }
+            Mem_Free(lineIds);
+            Mem_Free(uniqueSides);
+            Mem_Free(uniqueLines);
+            Mem_Free(slots);
+            Mem_Free(lineHashes);
+            
+            if (keptCountA > 0 && keptCountB > 0)
+            {
+                diff.forward = (int64_t *)Mem_Alloc(keptCountA + keptCountB + 4, sizeof(int64_t));
+                diff.backward = (int64_t *)Mem_Alloc(keptCountA + keptCountB + 4, sizeof(int64_t));
+                StringList_Internal_DiffCompare(&diff, 0, keptCountA, 0, keptCountB);
+                Mem_Free(diff.backward);
+                Mem_Free(diff.forward);
             }
         }
         
-        if (indexLastNonWhitespace >= 0 && indexLastNonWhitespace < string->count - 1)
+        // NOTE(s0lly): The gaps between consecutive matched lines are the edits
+        int64_t indexA = prefixCount;
+        int64_t indexB = prefixCount;
+        for (int64_t matchIndex = 0; matchIndex < diff.matchCount; matchIndex += 3)
+        {
+            for (int64_t offset = 0; offset < diff.matches[matchIndex + 2]; offset++)
+            {
+                int64_t matchA = diff.indicesA[diff.matches[matchIndex] + offset];
+                int64_t matchB = diff.indicesB[diff.matches[matchIndex + 1] + offset];
+                StringDiff_Internal_PushEdit(&result, listB, indexA, matchA - indexA, indexB, matchB - indexB);
+                indexA = matchA + 1;
+                indexB = matchB + 1;
+            }
+        }
+        StringDiff_Internal_PushEdit(&result, listB, indexA, countA - suffixCount - indexA, indexB, countB - suffixCount - indexB);
+        
+        Mem_Free(diff.matches);
+        Mem_Free(diff.indicesB);
+        Mem_Free(diff.indicesA);
+        Mem_Free(diff.idsB);
+        Mem_Free(diff.idsA);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
+}
+
+// NOTE(s0lly): Applies diff to the list it was made from, returning the new list. The edits must be in order and
+// within the list, and the diff must hold their inserted lines, otherwise the result is empty.
+static StringList StringList_Diff_Apply(StringList *stringList, StringDiff *diff)
+{
+    StringList result = { 0 };
+    if (stringList && diff)
+    {
+        int64_t count = stringList->e ? stringList->count : 0;
+        int64_t resultCount = count;
+        int64_t insertedCount = 0;
+        int64_t indexA = 0;
+        int32_t isValid = 1;
+        for (int64_t editIndex = 0; editIndex < diff->count && isValid; editIndex++)
         {
-            int64_t originalCount = string->count;
-            string->count = indexLastNonWhitespace + 1;
-            Mem_ClearBytes(string->e + string->count, originalCount - string->count);
+            StringDiffEdit *edit = &diff->e[editIndex];
+            isValid = (edit->indexA >= indexA && edit->countA >= 0 && edit->countB >= 0 && edit->indexA + edit->countA <= count);
+            indexA = edit->indexA + edit->countA;
+            resultCount += edit->countB - edit->countA;
+            insertedCount += edit->countB;
         }
-        else if (indexLastNonWhitespace == -1)
+        isValid = isValid && (insertedCount == diff->lines.count);
+        
+        if (isValid && resultCount > 0)
         {
-            int64_t originalCount = string->count;
-            string->count = 0;
-            Mem_ClearBytes(string->e, originalCount);
+            result = StringList_From_CountMax(resultCount);
+            int64_t lineIndex = 0;
+            indexA = 0;
+            for (int64_t editIndex = 0; editIndex <= diff->count; editIndex++)
+            {
+                int64_t keepEnd = (editIndex < diff->count) ? diff->e[editIndex].indexA : count;
+                for (; indexA < keepEnd; indexA++)
+                {
+                    StringList_PushCopy(&result, &stringList->e[indexA]);
+                }
+                if (editIndex < diff->count)
+                {
+                    for (int64_t insertIndex = 0; insertIndex < diff->e[editIndex].countB; insertIndex++)
+                    {
+                        StringList_PushCopy(&result, &diff->lines.e[lineIndex++]);
+                    }
+                    indexA += diff->e[editIndex].countA;
+                }
+            }
         }
     }
-    return msg;
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+    return result;
 }
 
-static StringMessage String_Remove_WhitespaceSurrounding(String *string)
+// NOTE(s0lly): Translate functions
+
+// NOTE(s0lly): The byte map of a translation or deletion, built once per call. The active bytes (those that change or
+// are deleted) are also kept as up to four runs of consecutive bytes that each move by one amount, which sse2 applies
+// 16 bytes at a time with compares and adds; other sets are classified 16 bytes at a time by nibble table shuffles when
+// ssse3 is available, and byte by byte otherwise.
+typedef struct String_Internal_ByteMap
 {
-    StringMessage msg = { 0 };
-    if (!string)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
-    }
-    else
-    {
-        String_Remove_WhitespacePrecending(string);
-        String_Remove_WhitespaceFollowing(string);
-    }
-    return msg;
-}
+    uint8_t map[256];
+    uint8_t isActive[256];
+    uint8_t runStart[4];
+    uint8_t runSpan[4];
+    uint8_t runDelta[4];
+    int32_t runCount;
+    
+    // NOTE(s0lly): Bit (high nibble & 7) of activeLow[low nibble] / activeHigh[low nibble] is set for active bytes
+    // below / from 0x80
+    uint8_t activeLow[16];
+    uint8_t activeHigh[16];
+    
+} String_Internal_ByteMap;
 
-static StringMessage String_ToUpper(String *string)
+// NOTE(s0lly): Maps fromSet[i] to toSet[i], or to the last byte of toSet past its end as tr does; with no toSet, the
+// bytes of fromSet are deleted. A byte listed twice takes its last mapping.
+static void String_Internal_ByteMap_Build(String_Internal_ByteMap *byteMap, String *fromSet, String *toSet)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    Mem_ClearBytes(byteMap, sizeof(*byteMap));
+    for (int32_t ch = 0; ch < 256; ch++)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+        byteMap->map[ch] = (uint8_t)ch;
     }
-    else if (!string->e)
+    for (int64_t setIndex = 0; setIndex < fromSet->count; setIndex++)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        uint8_t ch = fromSet->e[setIndex];
+        if (toSet)
+        {
+            byteMap->map[ch] = toSet->e[min(setIndex, toSet->count - 1)];
+            byteMap->isActive[ch] = (byteMap->map[ch] != ch);
+        }
+        else
+        {
+            byteMap->isActive[ch] = 1;
+        }
     }
-    else
+    
+    int32_t runCount = 0;
+    for (int32_t ch = 0; ch < 256; ch++)
     {
-        for (int64_t strIndex = 0; strIndex < string->count; strIndex++)
+        if (byteMap->isActive[ch])
         {
-            uint8_t *currentCh = String_Get(string, strIndex).chPtr;
-            *currentCh = (uint8_t)toupper(*currentCh);
+            uint8_t delta = (uint8_t)(byteMap->map[ch] - ch);
+            int32_t isRunContinued = (runCount > 0 && runCount <= 4 && ch > 0 && byteMap->isActive[ch - 1]
+                                      && byteMap->runDelta[runCount - 1] == delta);
+            if (isRunContinued)
+            {
+                byteMap->runSpan[runCount - 1]++;
+            }
+            else
+            {
+                if (runCount < 4)
+                {
+                    byteMap->runStart[runCount] = (uint8_t)ch;
+                    byteMap->runDelta[runCount] = delta;
+                }
+                runCount++;
+            }
+            if (ch < 0x80)
+            {
+                byteMap->activeLow[ch & 0x0F] |= (uint8_t)(1 << (ch >> 4));
+            }
+            else
+            {
+                byteMap->activeHigh[ch & 0x0F] |= (uint8_t)(1 << ((ch >> 4) & 7));
+            }
         }
     }
-    return msg;
+    byteMap->runCount = (runCount <= 4) ? runCount : -1;
 }
 
-static StringMessage String_ToLower(String *string)
+// NOTE(s0lly): Translates count bytes from src into dst, or copies them without the deleted bytes, and returns the
+// number written. dst may be src itself, or any buffer of count bytes that doesn't overlap it.
+static int64_t String_Internal_ByteMap_Apply(const String_Internal_ByteMap *byteMap, int32_t isDelete, const uint8_t *src, uint8_t *dst,
+                                             int64_t count)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    int64_t index = 0;
+    int64_t outCount = 0;
+#if defined(SCL_STRING_SSE2)
+    if (byteMap->runCount >= 0)
+    {
+        __m128i runStarts[4];
+        __m128i runSpans[4];
+        __m128i runDeltas[4];
+        for (int32_t runIndex = 0; runIndex < byteMap->runCount; runIndex++)
+        {
+            runStarts[runIndex] = _mm_set1_epi8((char)byteMap->runStart[runIndex]);
+            runSpans[runIndex] = _mm_set1_epi8((char)byteMap->runSpan[runIndex]);
+            runDeltas[runIndex] = _mm_set1_epi8((char)byteMap->runDelta[runIndex]);
+        }
+        for (; index + 16 <= count; index += 16)
+        {
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(src + index));
+            __m128i active = _mm_setzero_si128();
+            __m128i offset = _mm_setzero_si128();
+            for (int32_t runIndex = 0; runIndex < byteMap->runCount; runIndex++)
+            {
+                __m128i fromStart = _mm_sub_epi8(chunk, runStarts[runIndex]);
+                __m128i inRun = _mm_cmpeq_epi8(_mm_min_epu8(fromStart, runSpans[runIndex]), fromStart);
+                active = _mm_or_si128(active, inRun);
+                offset = _mm_or_si128(offset, _mm_and_si128(inRun, runDeltas[runIndex]));
+            }
+            if (!isDelete || !_mm_movemask_epi8(active))
+            {
+                _mm_storeu_si128((__m128i *)(dst + outCount), _mm_add_epi8(chunk, offset));
+                outCount += 16;
+            }
+            else
+            {
+                for (int64_t chunkIndex = index; chunkIndex < index + 16; chunkIndex++)
+                {
+                    uint8_t ch = src[chunkIndex];
+                    dst[outCount] = ch;
+                    outCount += !byteMap->isActive[ch];
+                }
+            }
+        }
+    }
+#if defined(SCL_STRING_SSSE3)
+    else
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+        __m128i activeLow = _mm_loadu_si128((const __m128i *)byteMap->activeLow);
+        __m128i activeHigh = _mm_loadu_si128((const __m128i *)byteMap->activeHigh);
+        __m128i nibbleBits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        __m128i nibbleMask = _mm_set1_epi8(0x0F);
+        for (; index + 16 <= count; index += 16)
+        {
+            __m128i chunk = _mm_loadu_si128((const __m128i *)(src + index));
+            __m128i lowNibbles = _mm_and_si128(chunk, nibbleMask);
+            __m128i isHigh = _mm_cmplt_epi8(chunk, _mm_setzero_si128());
+            __m128i rows = _mm_or_si128(_mm_andnot_si128(isHigh, _mm_shuffle_epi8(activeLow, lowNibbles)),
+                                        _mm_and_si128(isHigh, _mm_shuffle_epi8(activeHigh, lowNibbles)));
+            __m128i bits = _mm_shuffle_epi8(nibbleBits, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibbleMask));
+            uint32_t activeBits = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(rows, bits), bits));
+            if (!activeBits)
+            {
+                _mm_storeu_si128((__m128i *)(dst + outCount), chunk);
+                outCount += 16;
+            }
+            else if (!isDelete)
+            {
+                _mm_storeu_si128((__m128i *)(dst + outCount), chunk);
+                for (; activeBits; activeBits &= activeBits - 1)
+                {
+                    int64_t chunkIndex = Platform_CountTrailingZeros32(activeBits);
+                    dst[outCount + chunkIndex] = byteMap->map[src[index + chunkIndex]];
+                }
+                outCount += 16;
+            }
+            else
+            {
+                for (int64_t chunkIndex = index; chunkIndex < index + 16; chunkIndex++)
+                {
+                    uint8_t ch = src[chunkIndex];
+                    dst[outCount] = ch;
+                    outCount += !byteMap->isActive[ch];
+                }
+            }
+        }
     }
-    else if (!string->e)
+#endif
+#endif
+    if (isDelete)
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        // NOTE(s0lly): Eight independent lookups decide whether a word can be moved as it is
+        for (; index + 8 <= count; index += 8)
+        {
+            const uint8_t *word = src + index;
+            const uint8_t *isActive = byteMap->isActive;
+            if (!(isActive[word[0]] | isActive[word[1]] | isActive[word[2]] | isActive[word[3]]
+                  | isActive[word[4]] | isActive[word[5]] | isActive[word[6]] | isActive[word[7]]))
+            {
+                uint64_t wordValue;
+                memcpy(&wordValue, word, 8);
+                memcpy(dst + outCount, &wordValue, 8);
+                outCount += 8;
+            }
+            else
+            {
+                for (int64_t wordIndex = 0; wordIndex < 8; wordIndex++)
+                {
+                    uint8_t ch = word[wordIndex];
+                    dst[outCount] = ch;
+                    outCount += !isActive[ch];
+                }
+            }
+        }
+        for (; index < count; index++)
+        {
+            uint8_t ch = src[index];
+            dst[outCount] = ch;
+            outCount += !byteMap->isActive[ch];
+        }
     }
     else
     {
-        for (int64_t strIndex = 0; strIndex < string->count; strIndex++)
+        for (; index < count; index++)
         {
-            uint8_t *currentCh = String_Get(string, strIndex).chPtr;
-            *currentCh = (uint8_t)tolower(*currentCh);
+            dst[outCount++] = byteMap->map[src[index]];
         }
     }
-    return msg;
+    return outCount;
 }
 
-static StringMessage String_Find_FirstFrom(String *within, String *toFind, int64_t indexStart)
+// NOTE(s0lly): Replaces every byte of string found in fromSet by the byte at the same position in toSet (or by the last
+// byte of toSet, when toSet is shorter), in place and in one pass. The sets are taken byte by byte, without ranges.
+static StringMessage String_Translate(String *string, String *fromSet, String *toSet)
 {
-    StringMessage msg = { 0 };
-    if (!within || !toFind)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !fromSet || !toSet)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if (!within->e || !toFind->e)
+    else if (!string->e || !fromSet->e || !toSet->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (indexStart < 0 || indexStart >= within->count)
+    else if (fromSet->count > 0 && toSet->count == 0)
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
     }
     else
     {
-        uint8_t *foundPtr = (uint8_t *)strstr((char *)within->e + indexStart, (char *)toFind->e);
-        if (!foundPtr)
-        {
-            msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
-        }
-        else
-        {
-            msg.int64Val = (int64_t)(foundPtr - within->e);
-        }
+        String_Internal_ByteMap byteMap;
+        String_Internal_ByteMap_Build(&byteMap, fromSet, toSet);
+        String_Internal_Unshare(string);
+        msg.int64Val = String_Internal_ByteMap_Apply(&byteMap, 0, string->e, string->e, string->count);
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Find_LastFrom(String *within, String *toFind, int64_t indexStart)
+// NOTE(s0lly): Removes every byte of string found in set, in place and in one pass. int64Val holds the new count.
+static StringMessage String_DeleteChars(String *string, String *set)
 {
-    StringMessage msg = { 0 };
-    if (!within || !toFind)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !set)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if (!within->e || !toFind->e)
+    else if (!string->e || !set->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (indexStart < 0 || indexStart >= within->count)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
-    }
     else
     {
-        int64_t indexStartNew = (int64_t)indexStart;
-        StringMessage findMsg = String_Find_FirstFrom(within, toFind, indexStartNew);
-        
-        if (findMsg.code ==  SCL_STRING_CODE__FIND_NO_MATCH)
-        {
-            msg.code = SCL_STRING_CODE__FIND_NO_MATCH;
-        }
-        else
-        {
-            while(indexStartNew < within->count &&
-                  (findMsg.code != SCL_STRING_CODE__FIND_NO_MATCH))
-            {
-                msg.int64Val = findMsg.int64Val;
-                indexStartNew = findMsg.int64Val + 1;
-                findMsg = String_Find_FirstFrom(within, toFind, indexStartNew);
-            }
-        }
+        String_Internal_ByteMap byteMap;
+        String_Internal_ByteMap_Build(&byteMap, set, 0);
+        String_Internal_Unshare(string);
+        int64_t originalCount = string->count;
+        string->count = String_Internal_ByteMap_Apply(&byteMap, 1, string->e, string->e, originalCount);
+        Mem_ClearBytes(string->e + string->count, originalCount - string->count);
+        msg.int64Val = string->count;
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_Replace(String *string, String *newContents,
-                                    int64_t indexStartInclusive, int64_t indexEndInclusive)
+// NOTE(s0lly): As String_Translate, but appends the translated source to string and leaves source as it is (source may
+// be string itself). int64Val holds the number of bytes appended.
+static StringMessage String_Append_Translated(String *string, String *source, String *fromSet, String *toSet)
 {
-    StringMessage msg = { 0 };
-    if (!string)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !source || !fromSet || !toSet)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if (!string->e)
+    else if (!string->e || !source->e || !fromSet->e || !toSet->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (indexStartInclusive < 0 || indexStartInclusive >= string->count ||
-             indexEndInclusive < 0 || indexEndInclusive >= string->count ||
-             indexStartInclusive > indexEndInclusive)
+    else if (fromSet->count > 0 && toSet->count == 0)
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        msg.code = SCL_STRING_CODE__ERROR_INVALID_STRING_COUNT_PASSED_TO_FUNCTION;
     }
     else
     {
-        msg = String_Remove(string, indexStartInclusive, indexEndInclusive);
-        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
-        {
-            msg = String_Insert_String(string, newContents, indexStartInclusive);
-        }
+        String_Internal_ByteMap byteMap;
+        String_Internal_ByteMap_Build(&byteMap, fromSet, toSet);
+        int64_t sourceCount = source->count;
+        String_Internal_ReserveAppend(string, sourceCount);
+        msg.int64Val = String_Internal_ByteMap_Apply(&byteMap, 0, source->e, string->e + string->count, sourceCount);
+        string->count += msg.int64Val;
+        string->e[string->count] = '\0';
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_FindReplaceFrom(String *string, String *oldContents, String *newContents, int64_t indexStart)
+// NOTE(s0lly): As String_DeleteChars, but appends source without the bytes in set to string and leaves source as it is
+// (source may be string itself). int64Val holds the number of bytes appended.
+static StringMessage String_Append_DeletedChars(String *string, String *source, String *set)
 {
-    StringMessage msg = { 0 };
-    if (!string || !oldContents || !newContents)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!string || !source || !set)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    else if (!string->e || !oldContents->e || !newContents->e)
+    else if (!string->e || !source->e || !set->e)
     {
         msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
     }
-    else if (indexStart < 0 || indexStart >= string->count)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
-    }
     else
     {
-        msg = String_Find_FirstFrom(string, oldContents, indexStart);
-        if (msg.code == SCL_STRING_CODE__NO_MESSAGE)
-        {
-            int64_t firstFind = msg.int64Val;
-            msg = String_Replace(string, newContents, firstFind, firstFind + oldContents->count - 1);
-        }
+        String_Internal_ByteMap byteMap;
+        String_Internal_ByteMap_Build(&byteMap, set, 0);
+        int64_t sourceCount = source->count;
+        String_Internal_ReserveAppend(string, sourceCount);
+        msg.int64Val = String_Internal_ByteMap_Apply(&byteMap, 1, source->e, string->e + string->count, sourceCount);
+        string->count += msg.int64Val;
+        string->e[string->count] = '\0';
     }
+    SCL_STRING_STATS_RECORD(msg.code);
     return msg;
 }
 
-static StringMessage String_FindReplaceFrom_All(String *string, String *oldContents, String *newContents,
-                                                int64_t indexStart)
+// NOTE(s0lly): Counter functions
+
+#define SCL_STRING_COUNTER_BLOCK_COUNT 65536
+#define SCL_STRING_COUNTER_SLOT_COUNT_MIN 1024
+#define SCL_STRING_COUNTER_BATCH_COUNT 16
+
+typedef struct StringCounter_Internal_AddContext
 {
-    StringMessage msg = { 0 };
-    if (!string || !oldContents || !newContents)
-    {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
-    }
-    else if (!string->e || !oldContents->e || !newContents->e)
+    StringCounter *counter;
+    StringList *stringList;
+    String *string;
+    
+} StringCounter_Internal_AddContext;
+
+typedef struct StringCounter_Internal_TopKContext
+{
+    StringCounter *counter;
+    int64_t k;
+    int32_t partitionCount;
+    StringCounterSlot **candidates;
+    int64_t *candidateCounts;
+    
+} StringCounter_Internal_TopKContext;
+
+static int32_t StringCounter_Internal_Partition(uint64_t hash, int32_t partitionCount)
+{
+    return (int32_t)(((hash >> 32) * (uint64_t)partitionCount) >> 32);
+}
+
+// NOTE(s0lly): Returns the slot holding token, or the empty slot where it belongs
+static StringCounterSlot *StringCounterTable_Internal_Find(StringCounterTable *table, uint64_t hash, const uint8_t *token, int64_t tokenCount)
+{
+    uint64_t slotMask = (uint64_t)table->slotCount - 1;
+    uint64_t slotIndex = hash & slotMask;
+    StringCounterSlot *slot = &table->slots[slotIndex];
+    while (slot->count && !(slot->hash == hash && slot->tokenCount == tokenCount && memcmp(slot->token, token, tokenCount) == 0))
     {
-        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+        slotIndex = (slotIndex + 1) & slotMask;
+        slot = &table->slots[slotIndex];
     }
-    else if (indexStart < 0 || indexStart >= string->count)
+    return slot;
+}
+
+static void StringCounterTable_Internal_Resize(StringCounterTable *table, int64_t slotCountNew)
+{
+    StringCounterSlot *slotsOld = table->slots;
+    int64_t slotCountOld = table->slotCount;
+    table->slots = (StringCounterSlot *)Mem_Alloc(slotCountNew, sizeof(StringCounterSlot));
+    table->slotCount = slotCountNew;
+    for (int64_t slotIndex = 0; slotIndex < slotCountOld; slotIndex++)
     {
-        msg.code = SCL_STRING_CODE__ERROR_OUT_OF_RANGE_INDEX_PASSED_TO_FUNCTION;
+        if (slotsOld[slotIndex].count)
+        {
+            uint64_t slotIndexNew = slotsOld[slotIndex].hash & (uint64_t)(slotCountNew - 1);
+            while (table->slots[slotIndexNew].count)
+            {
+                slotIndexNew = (slotIndexNew + 1) & (uint64_t)(slotCountNew - 1);
+            }
+            table->slots[slotIndexNew] = slotsOld[slotIndex];
+        }
     }
-    else
+    Mem_Free(slotsOld);
+}
+
+// NOTE(s0lly): Token bytes are appended to the table's current block, so that a token costs no allocation of its own
+static uint8_t *StringCounterTable_Internal_CopyToken(StringCounterTable *table, const uint8_t *token, int64_t tokenCount)
+{
+    if (table->blockCount == 0 || table->blockUsed + tokenCount > SCL_STRING_COUNTER_BLOCK_COUNT)
     {
-        msg = String_Find_FirstFrom(string, oldContents, indexStart);
-        while(msg.code == SCL_STRING_CODE__NO_MESSAGE)
+        if (table->blockCount >= table->blockCountMax)
         {
-            int64_t firstFind = msg.int64Val;
-            msg = String_Replace(string, newContents, firstFind, firstFind + oldContents->count - 1);
+            int64_t blockCountMaxNew = max(table->blockCountMax * 2, 16);
+            uint8_t **blocksNew = (uint8_t **)Mem_Alloc(blockCountMaxNew, sizeof(uint8_t *));
+            if (table->blocks)
+            {
+                memcpy(blocksNew, table->blocks, table->blockCount * sizeof(uint8_t *));
+                Mem_Free(table->blocks);
+            }
+            table->blocks = blocksNew;
+            table->blockCountMax = blockCountMaxNew;
         }
+        table->blocks[table->blockCount++] = (uint8_t *)Mem_Alloc(max(tokenCount, SCL_STRING_COUNTER_BLOCK_COUNT), sizeof(uint8_t));
+        table->blockUsed = 0;
     }
-    return msg;
+    uint8_t *result = table->blocks[table->blockCount - 1] + table->blockUsed;
+    memcpy(result, token, tokenCount);
+    table->blockUsed += tokenCount;
+    return result;
 }
 
-
-// NOTE(s0lly): StringList functions
-
-static String *StringList_Get(StringList *stringList, int64_t index)
+static void StringCounterTable_Internal_Destroy(StringCounterTable *table)
 {
-    String *result = 0;
-    if (stringList && stringList->e && index >= 0 && index < stringList->count)
+    for (int64_t blockIndex = 0; blockIndex < table->blockCount; blockIndex++)
     {
-        result = &stringList->e[index];
+        Mem_Free(table->blocks[blockIndex]);
     }
-    return result;
+    Mem_Free(table->blocks);
+    Mem_Free(table->slots);
+    Mem_ClearBytes(table, sizeof(*table));
 }
 
-static void StringList_Destroy(StringList *stringList)
+static int StringCounter_Internal_CompareCounts(const void *a, const void *b)
 {
-    if (stringList)
+    int64_t countA = *(const int64_t *)a;
+    int64_t countB = *(const int64_t *)b;
+    return (countA > countB) - (countA < countB);
+}
+
+// NOTE(s0lly): Approximate mode, for a full table: subtracts the median count from every count and drops the tokens
+// that reach 0 (Misra-Gries with batched decrements), which frees at least half of the table. Each purge removes at
+// least capacity / 2 * median from the counts, so errorBound stays below 2 * totalCount / capacity.
+static void StringCounterTable_Internal_Purge(StringCounterTable *table)
+{
+    int64_t *counts = (int64_t *)Mem_Alloc(table->usedCount, sizeof(int64_t));
+    int64_t usedIndex = 0;
+    for (int64_t slotIndex = 0; slotIndex < table->slotCount; slotIndex++)
     {
-        if (stringList->e)
+        if (table->slots[slotIndex].count)
         {
-            for (int64_t stringIndex = 0; stringIndex < stringList->count; stringIndex++)
-            {
-                String *currentString = StringList_Get(stringList, stringIndex);
-                if (currentString && currentString->e)
-                {
-                    String_Destroy(currentString);
-                }
-            }
-            free(stringList->e);
+            counts[usedIndex++] = table->slots[slotIndex].count;
+        }
+    }
+    qsort(counts, usedIndex, sizeof(int64_t), StringCounter_Internal_CompareCounts);
+    int64_t median = counts[usedIndex / 2];
+    Mem_Free(counts);
+    
+    StringCounterTable tableOld = *table;
+    table->slots = (StringCounterSlot *)Mem_Alloc(tableOld.slotCount, sizeof(StringCounterSlot));
+    table->usedCount = 0;
+    table->blocks = 0;
+    table->blockCount = 0;
+    table->blockCountMax = 0;
+    table->blockUsed = 0;
+    table->errorBound += median;
+    for (int64_t slotIndex = 0; slotIndex < tableOld.slotCount; slotIndex++)
+    {
+        StringCounterSlot *slotOld = &tableOld.slots[slotIndex];
+        if (slotOld->count > median)
+        {
+            StringCounterSlot *slot = StringCounterTable_Internal_Find(table, slotOld->hash, slotOld->token, slotOld->tokenCount);
+            slot->hash = slotOld->hash;
+            slot->token = StringCounterTable_Internal_CopyToken(table, slotOld->token, slotOld->tokenCount);
+            slot->tokenCount = slotOld->tokenCount;
+            slot->count = slotOld->count - median;
+            table->usedCount++;
         }
-        *stringList = (StringList) { 0 }; 
     }
+    StringCounterTable_Internal_Destroy(&tableOld);
 }
 
-static StringList StringList_From_CountMax(int64_t countMax)
+static void StringCounterTable_Internal_Add(StringCounterTable *table, int64_t capacity, const uint8_t *token, int64_t tokenCount, uint64_t hash)
 {
-    StringList result = { 0 };
-    if (countMax > 0)
+    StringCounterSlot *slot = StringCounterTable_Internal_Find(table, hash, token, tokenCount);
+    if (!slot->count)
     {
-        result.countMax = countMax;
-        result.e = calloc(result.countMax, sizeof(String));
-        
+        if (capacity > 0 && table->usedCount >= capacity)
+        {
+            StringCounterTable_Internal_Purge(table);
+            slot = StringCounterTable_Internal_Find(table, hash, token, tokenCount);
+        }
+        else if (capacity == 0 && (table->usedCount + 1) * 4 > table->slotCount * 3)
+        {
+            StringCounterTable_Internal_Resize(table, table->slotCount * 2);
+            slot = StringCounterTable_Internal_Find(table, hash, token, tokenCount);
+        }
+        slot->hash = hash;
+        slot->token = StringCounterTable_Internal_CopyToken(table, token, tokenCount);
+        slot->tokenCount = tokenCount;
+        table->usedCount++;
     }
-    return result;
+    slot->count++;
+    table->totalCount++;
 }
 
-static void StringList_Resize(StringList *stringList, int64_t countMaxNew)
+// NOTE(s0lly): Tokens are hashed a batch at a time, so that their slots can be prefetched before they are looked up
+static void StringCounter_Internal_AddBytes(StringCounter *counter, StringCounterTable *table, const uint8_t *data, int64_t count)
 {
-    if (countMaxNew > 0)
+    if (!table->slots)
     {
-        if (stringList && stringList->e)
+        int64_t slotCount = SCL_STRING_COUNTER_SLOT_COUNT_MIN;
+        while (counter->capacity > 0 && slotCount < counter->capacity * 2)
+        {
+            slotCount *= 2;
+        }
+        table->slots = (StringCounterSlot *)Mem_Alloc(slotCount, sizeof(StringCounterSlot));
+        table->slotCount = slotCount;
+    }
+    
+    const uint8_t *isDelimiter = counter->isDelimiter;
+    int64_t tokenStarts[SCL_STRING_COUNTER_BATCH_COUNT];
+    int64_t tokenCounts[SCL_STRING_COUNTER_BATCH_COUNT];
+    uint64_t hashes[SCL_STRING_COUNTER_BATCH_COUNT];
+    int64_t index = 0;
+    while (index < count)
+    {
+        int32_t batchCount = 0;
+        while (index < count && batchCount < SCL_STRING_COUNTER_BATCH_COUNT)
         {
-            StringList result = { 0 };
-            result = StringList_From_CountMax(countMaxNew);
-            for (int64_t stringIndex = 0; stringIndex < min(countMaxNew, stringList->count); stringIndex++)
+            while (index < count && isDelimiter[data[index]])
+            {
+                index++;
+            }
+            int64_t tokenStart = index;
+            while (index < count && !isDelimiter[data[index]])
             {
-                result.e[stringIndex] = String_From_String(StringList_Get(stringList, stringIndex)).string;
+                index++;
+            }
+            if (index > tokenStart)
+            {
+                tokenStarts[batchCount] = tokenStart;
+                tokenCounts[batchCount] = index - tokenStart;
+                hashes[batchCount] = String_Internal_HashBytes(data + tokenStart, index - tokenStart);
+#if defined(SCL_STRING_SSE2)
+                _mm_prefetch((const char *)&table->slots[hashes[batchCount] & (uint64_t)(table->slotCount - 1)], _MM_HINT_T0);
+#endif
+                batchCount++;
             }
-            result.count = stringList->count;
-            StringList_Destroy(stringList);
-            *stringList = result;
         }
-        else
+        for (int32_t batchIndex = 0; batchIndex < batchCount; batchIndex++)
         {
-            *stringList = StringList_From_CountMax(countMaxNew);
+            StringCounterTable_Internal_Add(table, counter->capacity, data + tokenStarts[batchIndex], tokenCounts[batchIndex], hashes[batchIndex]);
         }
     }
-    else
+}
+
+// NOTE(s0lly): Makes sure that every thread of the pool has a table of its own
+static void StringCounter_Internal_Reserve(StringCounter *counter, StringThreadPool *pool)
+{
+    int32_t threadCount = StringThreadPool_Get_ThreadCount(pool);
+    if (threadCount > counter->tableCount)
     {
-        StringList_Destroy(stringList);
+        StringCounterTable *tablesNew = (StringCounterTable *)Mem_Alloc(threadCount, sizeof(StringCounterTable));
+        if (counter->tables)
+        {
+            memcpy(tablesNew, counter->tables, counter->tableCount * sizeof(StringCounterTable));
+            Mem_Free(counter->tables);
+        }
+        counter->tables = tablesNew;
+        counter->tableCount = threadCount;
     }
 }
 
-static void StringList_PushCopy(StringList *stringList, String *string)
+static void StringCounter_Internal_AddListRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
 {
-    if (stringList && string)
+    StringCounter_Internal_AddContext *add = (StringCounter_Internal_AddContext *)context;
+    StringCounterTable *table = &add->counter->tables[workerIndex];
+    for (int64_t index = indexStart; index < indexEnd; index++)
     {
-        if (stringList->e)
+        String *string = &add->stringList->e[index];
+        if (string->e)
         {
-            if (stringList->count >= stringList->countMax)
-            {
-                StringList_Resize(stringList, stringList->countMax * 2);
-            }
+            StringCounter_Internal_AddBytes(add->counter, table, string->e, string->count);
         }
-        else
+    }
+}
+
+// NOTE(s0lly): A token belongs to the range it starts in, so each range skips the end of a token that started before
+// it and finishes the last token that it starts
+static void StringCounter_Internal_AddStringRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    StringCounter_Internal_AddContext *add = (StringCounter_Internal_AddContext *)context;
+    const uint8_t *isDelimiter = add->counter->isDelimiter;
+    const uint8_t *data = add->string->e;
+    int64_t count = add->string->count;
+    while (indexStart > 0 && indexStart < indexEnd && !isDelimiter[data[indexStart - 1]])
+    {
+        indexStart++;
+    }
+    if (indexStart < indexEnd)
+    {
+        while (indexEnd < count && !isDelimiter[data[indexEnd - 1]])
         {
-            *stringList = StringList_From_CountMax(1);
+            indexEnd++;
         }
-        
-        stringList->e[stringList->count] = String_From_String(string).string;
-        stringList->count++;
+        StringCounter_Internal_AddBytes(add->counter, &add->counter->tables[workerIndex], data + indexStart, indexEnd - indexStart);
     }
 }
 
-static StringList StringList_From_String_SplitByDelimiters(String *string, String *delimiters, String *ignoreChs)
+// NOTE(s0lly): Orders by count, highest first, and then by token
+static int32_t StringCounter_Internal_IsBefore(const StringCounterSlot *a, const StringCounterSlot *b)
 {
-    StringList result = { 0 };
-    if (string && string->e && delimiters && delimiters->e && ignoreChs && ignoreChs->e)
+    int32_t result = (a->count > b->count);
+    if (a->count == b->count)
     {
-        result = StringList_From_CountMax(1);
-        
-        int64_t cursorIndex = 0;
-        int64_t dataCounter = 0;
-        
-        while(cursorIndex <= string->count)
+        int32_t order = memcmp(a->token, b->token, min(a->tokenCount, b->tokenCount));
+        result = (order < 0) || (order == 0 && a->tokenCount < b->tokenCount);
+    }
+    return result;
+}
+
+static int StringCounter_Internal_CompareSlots(const void *a, const void *b)
+{
+    const StringCounterSlot *slotA = (const StringCounterSlot *)a;
+    const StringCounterSlot *slotB = (const StringCounterSlot *)b;
+    return StringCounter_Internal_IsBefore(slotB, slotA) - StringCounter_Internal_IsBefore(slotA, slotB);
+}
+
+// NOTE(s0lly): Keeps the k best slots seen so far in a heap whose root is the worst of them
+static void StringCounter_Internal_HeapPush(StringCounterSlot *heap, int64_t *heapCount, int64_t k, const StringCounterSlot *slot)
+{
+    int64_t index = 0;
+    if (*heapCount < k)
+    {
+        index = (*heapCount)++;
+        while (index > 0 && StringCounter_Internal_IsBefore(&heap[(index - 1) / 2], slot))
         {
-            int64_t startCellIndex = cursorIndex;
-            int64_t endCellIndex = -1;
-            int32_t isEmptyCell = 0;
-            int32_t isInIgnorableRegion = 0;
-            int64_t ignoreCharCounter = 0;
-            
-            
-            for (int64_t i = 0; i < ignoreChs->count; i++)
-            {
-                if (string->e[cursorIndex] == ignoreChs->e[i])
-                {
-                    isInIgnorableRegion = 1;
-                    ignoreCharCounter++;
-                    cursorIndex++;
-                }
-            }
-            
-            // TODO(s0lly): Need to think through how to handle all ignorables
-            while(cursorIndex <= string->count && endCellIndex == -1 && !isEmptyCell)
+            heap[index] = heap[(index - 1) / 2];
+            index = (index - 1) / 2;
+        }
+        heap[index] = *slot;
+    }
+    else if (StringCounter_Internal_IsBefore(slot, &heap[0]))
+    {
+        for (;;)
+        {
+            int64_t child = index * 2 + 1;
+            if (child >= k)
             {
-                uint8_t *currentChar = &string->e[cursorIndex]; 
-                
-                for (int64_t i = 0; i < delimiters->count; i++)
-                {
-                    if ((*currentChar == delimiters->e[i]) && ignoreCharCounter == 0)
-                    {
-                        if (cursorIndex == startCellIndex)
-                        {
-                            isEmptyCell = 1;
-                        }
-                        endCellIndex = cursorIndex - 1;
-                    }
-                }
-                
-                for (int64_t i = 0; i < ignoreChs->count; i++)
-                {
-                    if (*currentChar == ignoreChs->e[i])
-                    {
-                        ignoreCharCounter = 1 - ignoreCharCounter;
-                    }
-                }
-                
-                cursorIndex++;
+                break;
             }
-            
-            if (endCellIndex == -1 && !isEmptyCell)
+            if (child + 1 < k && StringCounter_Internal_IsBefore(&heap[child], &heap[child + 1]))
             {
-                endCellIndex = string->countMax - 1;
+                child++;
             }
-            
-            if (cursorIndex > (int64_t)strlen((const char *)string->e) && endCellIndex == -1)
+            if (!StringCounter_Internal_IsBefore(slot, &heap[child]))
             {
-                String tempString = String_From_CStr("").string;
-                StringList_PushCopy(&result, &tempString);
-                String_Destroy(&tempString);
                 break;
             }
-            
-            if (endCellIndex != -1 && !isEmptyCell)
+            heap[index] = heap[child];
+            index = child;
+        }
+        heap[index] = *slot;
+    }
+}
+
+// NOTE(s0lly): Sums the counts of one hash partition over every table, then keeps its best k. The merged slots point at
+// the tables' own token bytes.
+static void StringCounter_Internal_TopKRange(void *context, int64_t indexStart, int64_t indexEnd, int32_t workerIndex)
+{
+    (void)workerIndex;
+    StringCounter_Internal_TopKContext *topK = (StringCounter_Internal_TopKContext *)context;
+    StringCounter *counter = topK->counter;
+    for (int64_t partition = indexStart; partition < indexEnd; partition++)
+    {
+        StringCounterTable merged = { 0 };
+        merged.slotCount = SCL_STRING_COUNTER_SLOT_COUNT_MIN;
+        merged.slots = (StringCounterSlot *)Mem_Alloc(merged.slotCount, sizeof(StringCounterSlot));
+        for (int32_t tableIndex = 0; tableIndex < counter->tableCount; tableIndex++)
+        {
+            StringCounterTable *table = &counter->tables[tableIndex];
+            for (int64_t slotIndex = 0; slotIndex < table->slotCount; slotIndex++)
             {
-                if (isInIgnorableRegion)
-                {
-                    startCellIndex ++;
-                    endCellIndex--;
-                }
-                
-                int64_t destIndex = 0;
-                int64_t srcIndex = startCellIndex;
-                
-                // TODO(s0lly): hits out of bounds on end of string - fix
-                uint8_t originalDelimited = string->e[endCellIndex + 1];
-                string->e[endCellIndex + 1] = 0;
-                
-                ignoreCharCounter = 0;
-                
-                // TODO(s0lly): allow for larger sizes?
-                uint8_t *segment = calloc(4096, sizeof(uint8_t)); 
-                
-                while(srcIndex <= endCellIndex)
+                StringCounterSlot *slot = &table->slots[slotIndex];
+                if (slot->count && StringCounter_Internal_Partition(slot->hash, topK->partitionCount) == partition)
                 {
-                    if (string->e[srcIndex] == '\"')
+                    StringCounterSlot *mergedSlot = StringCounterTable_Internal_Find(&merged, slot->hash, slot->token, slot->tokenCount);
+                    if (!mergedSlot->count)
                     {
-                        if (ignoreCharCounter == 0)
-                        {
-                            ignoreCharCounter++;
-                        }
-                        else
+                        if ((merged.usedCount + 1) * 4 > merged.slotCount * 3)
                         {
-                            segment[destIndex] = '\"';
-                            destIndex++;
-                            ignoreCharCounter = 0;
+                            StringCounterTable_Internal_Resize(&merged, merged.slotCount * 2);
+                            mergedSlot = StringCounterTable_Internal_Find(&merged, slot->hash, slot->token, slot->tokenCount);
                         }
+                        *mergedSlot = *slot;
+                        mergedSlot->count = 0;
+                        merged.usedCount++;
                     }
-                    else
-                    {
-                        segment[destIndex] = string->e[srcIndex];
-                        destIndex++;
-                    }
-                    
-                    srcIndex++;
-                    
+                    mergedSlot->count += slot->count;
                 }
-                
-                String tempString = String_From_CStr((const char *)segment).string;
-                StringList_PushCopy(&result, &tempString);
-                String_Destroy(&tempString);
-                
-                string->e[endCellIndex + 1] = originalDelimited;
-                startCellIndex = cursorIndex;
             }
-            else
+        }
+        
+        int64_t k = (topK->k > 0) ? min(topK->k, merged.usedCount) : merged.usedCount;
+        StringCounterSlot *candidates = (StringCounterSlot *)Mem_Alloc(max(k, 1), sizeof(StringCounterSlot));
+        int64_t candidateCount = 0;
+        for (int64_t slotIndex = 0; slotIndex < merged.slotCount; slotIndex++)
+        {
+            if (merged.slots[slotIndex].count)
             {
-                String tempString = String_From_CStr("").string;
-                StringList_PushCopy(&result, &tempString);
-                String_Destroy(&tempString);
-                
-                startCellIndex = cursorIndex;
+                StringCounter_Internal_HeapPush(candidates, &candidateCount, k, &merged.slots[slotIndex]);
             }
-            
-            dataCounter++;
         }
+        topK->candidates[partition] = candidates;
+        topK->candidateCounts[partition] = candidateCount;
+        Mem_Free(merged.slots);
     }
-    return result;
 }
 
-static StringList StringList_From_File(File *file)
+// NOTE(s0lly): Tokens are the runs of bytes between the bytes of delimiters. capacity 0 counts every token exactly;
+// otherwise each thread keeps at most capacity distinct tokens (Misra-Gries), so that memory stays bounded and every
+// token seen more than 2 * totalCount / capacity times per thread is kept.
+static StringCounter StringCounter_Create(String *delimiters, int64_t capacity)
 {
-    StringList result = { 0 };
-    
-    if (file && file->handle)
+    StringCounter result = { 0 };
+    if (delimiters && delimiters->e && capacity >= 0)
     {
-        String fileStr = String_From_FileNextLine(file).string;
-        
-        while(fileStr.e)
+        result.capacity = capacity;
+        for (int64_t delimiterIndex = 0; delimiterIndex < delimiters->count; delimiterIndex++)
         {
-            StringList_PushCopy(&result, &fileStr);
-            String_Reinit_FileNextLine(&fileStr, file);
+            result.isDelimiter[delimiters->e[delimiterIndex]] = 1;
         }
-        String_Destroy(&fileStr);
+        StringCounter_Internal_Reserve(&result, 0);
     }
-    
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
     return result;
 }
 
-static StringList StringList_From_Filename_String(String *filename)
+static void StringCounter_Destroy(StringCounter *counter)
 {
-    StringList result = { 0 };
-    
-    if (filename && filename->e)
+    if (counter)
     {
-        File file = { 0 };
-        file.handle = fopen((const char *)filename->e, "rb");
-        if (file.handle)
+        for (int32_t tableIndex = 0; tableIndex < counter->tableCount; tableIndex++)
         {
-            result = StringList_From_File(&file);
+            StringCounterTable_Internal_Destroy(&counter->tables[tableIndex]);
         }
-        
-        fclose(file.handle);
+        Mem_Free(counter->tables);
+        Mem_ClearBytes(counter, sizeof(*counter));
     }
-    
-    return result;
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
 }
 
-static StringList StringList_From_Filename_CStr(const char *cStr)
+// NOTE(s0lly): Counts the tokens of string, splitting it into byte ranges for the pool's workers (null runs serially).
+// Only the distinct tokens are copied.
+static StringMessage StringCounter_Add_String(StringThreadPool *pool, StringCounter *counter, String *string)
 {
-    StringList result = { 0 };
-    
-    if (cStr)
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!counter || !string)
     {
-        String filename = String_From_CStr(cStr).string;
-        result = StringList_From_Filename_String(&filename);
-        String_Destroy(&filename);
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
     }
-    
+    else if (!counter->tables || !string->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        StringCounter_Internal_Reserve(counter, pool);
+        StringCounter_Internal_AddContext add = { 0 };
+        add.counter = counter;
+        add.string = string;
+        StringThreadPool_Run(pool, string->count, 1 << 20, StringCounter_Internal_AddStringRange, &add);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Counts the tokens of every element of stringList, spread over the pool's workers (null runs serially)
+static StringMessage StringCounter_Add_StringList(StringThreadPool *pool, StringCounter *counter, StringList *stringList)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!counter || !stringList)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!counter->tables || !stringList->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        StringCounter_Internal_Reserve(counter, pool);
+        StringCounter_Internal_AddContext add = { 0 };
+        add.counter = counter;
+        add.stringList = stringList;
+        StringThreadPool_Run(pool, stringList->count, 0, StringCounter_Internal_AddListRange, &add);
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): int64Val holds the count of token (a lower bound in approximate mode)
+static StringMessage StringCounter_Get(StringCounter *counter, String *token)
+{
+    StringMessage msg = { SCL_STRING_CODE__NO_MESSAGE };
+    if (!counter || !token)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_STRING_PASSED_TO_FUNCTION;
+    }
+    else if (!counter->tables || !token->e)
+    {
+        msg.code = SCL_STRING_CODE__ERROR_NULL_DATA_PASSED_TO_FUNCTION;
+    }
+    else
+    {
+        uint64_t hash = String_Internal_HashBytes(token->e, token->count);
+        for (int32_t tableIndex = 0; tableIndex < counter->tableCount; tableIndex++)
+        {
+            StringCounterTable *table = &counter->tables[tableIndex];
+            if (table->slots)
+            {
+                msg.int64Val += StringCounterTable_Internal_Find(table, hash, token->e, token->count)->count;
+            }
+        }
+    }
+    SCL_STRING_STATS_RECORD(msg.code);
+    return msg;
+}
+
+// NOTE(s0lly): Returns the k most frequent tokens (every token, for k <= 0), as copies. The tables are merged one hash
+// partition per worker, each partition keeps its best k in a heap, and only those are sorted.
+static StringCounterEntries StringCounter_TopK(StringThreadPool *pool, StringCounter *counter, int64_t k)
+{
+    StringCounterEntries result = { 0 };
+    if (counter && counter->tables)
+    {
+        int64_t errorBound = 0;
+        for (int32_t tableIndex = 0; tableIndex < counter->tableCount; tableIndex++)
+        {
+            result.totalCount += counter->tables[tableIndex].totalCount;
+            errorBound += counter->tables[tableIndex].errorBound;
+        }
+        
+        StringCounter_Internal_TopKContext topK = { 0 };
+        topK.counter = counter;
+        topK.k = k;
+        topK.partitionCount = StringThreadPool_Get_ThreadCount(pool);
+        topK.candidates = (StringCounterSlot **)Mem_Alloc(topK.partitionCount, sizeof(StringCounterSlot *));
+        topK.candidateCounts = (int64_t *)Mem_Alloc(topK.partitionCount, sizeof(int64_t));
+        StringThreadPool_Run(pool, topK.partitionCount, 1, StringCounter_Internal_TopKRange, &topK);
+        
+        int64_t candidateCount = 0;
+        for (int32_t partition = 0; partition < topK.partitionCount; partition++)
+        {
+            candidateCount += topK.candidateCounts[partition];
+        }
+        StringCounterSlot *candidates = (StringCounterSlot *)Mem_Alloc(max(candidateCount, 1), sizeof(StringCounterSlot));
+        candidateCount = 0;
+        for (int32_t partition = 0; partition < topK.partitionCount; partition++)
+        {
+            memcpy(candidates + candidateCount, topK.candidates[partition], topK.candidateCounts[partition] * sizeof(StringCounterSlot));
+            candidateCount += topK.candidateCounts[partition];
+            Mem_Free(topK.candidates[partition]);
+        }
+        qsort(candidates, candidateCount, sizeof(StringCounterSlot), StringCounter_Internal_CompareSlots);
+        
+        result.count = (k > 0) ? min(k, candidateCount) : candidateCount;
+        if (result.count > 0)
+        {
+            result.e = (StringCounterEntry *)Mem_Alloc(result.count, sizeof(StringCounterEntry));
+            for (int64_t entryIndex = 0; entryIndex < result.count; entryIndex++)
+            {
+                StringCounterSlot *candidate = &candidates[entryIndex];
+                result.e[entryIndex].token = String_Internal_CopyStringIntoMessage(candidate->token, candidate->tokenCount, candidate->tokenCount).string;
+                result.e[entryIndex].count = candidate->count;
+                result.e[entryIndex].error = errorBound;
+            }
+        }
+        Mem_Free(candidates);
+        Mem_Free(topK.candidateCounts);
+        Mem_Free(topK.candidates);
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
     return result;
 }
 
+static void StringCounterEntries_Destroy(StringCounterEntries *entries)
+{
+    if (entries)
+    {
+        for (int64_t entryIndex = 0; entryIndex < entries->count; entryIndex++)
+        {
+            String_Destroy(&entries->e[entryIndex].token);
+        }
+        Mem_Free(entries->e);
+        Mem_ClearBytes(entries, sizeof(*entries));
+    }
+    SCL_STRING_STATS_RECORD(SCL_STRING_CODE__NO_MESSAGE);
+}
 
 // NOTE(s0lly): Undefines
 
 #undef Mem_ClearBytes
+#undef Mem_Alloc
+#undef Mem_Free
 #undef _CRT_SECURE_NO_WARNINGS
 
+// NOTE(s0lly): Only the min / max defined above are removed - msvc's own stay visible to the includer
+#ifdef SCL_STRING_DEFINED_MIN
+#undef min
+#undef SCL_STRING_DEFINED_MIN
+#endif
+#ifdef SCL_STRING_DEFINED_MAX
+#undef max
+#undef SCL_STRING_DEFINED_MAX
+#endif
+
 
 // NOTE(s0lly): License information
 
@@ -0,0 +1,473 @@
+
+/*********************************************************************************************************
+
+File Name           : SCL_String.hpp
+Author              : s0lly
+License             : The Unlicense / Public Domain (see SCL_String.h for license description)
+
+C++ wrapper around SCL_String.h. Requires C++17 (std::string_view).
+
+scl::String and scl::StringList own a String / StringList and destroy it when they go out of scope. Moving one hands
+its buffer over without copying; copying is never implicit, and goes through Copy(), which is O(1) for strings that
+have been shared with Share(). Both convert to std::string_view without copying, and a StringList can be walked with
+range-for as a sequence of std::string_view.
+
+The underlying C structs are always available via Get(), so every function in SCL_String.h still applies.
+*********************************************************************************************************/
+
+#pragma once
+
+// NOTE(s0lly): windows.h defines min / max macros, which break std::min / std::max
+#if defined(_WIN32) && !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+#include "SCL_String.h"
+
+namespace scl
+{
+    constexpr bool IsOk(SCL_STRING_CODE code) noexcept
+    {
+        return code == SCL_STRING_CODE__NO_MESSAGE;
+    }
+    
+    inline std::string_view View(const ::String &string) noexcept
+    {
+        return string.e ? std::string_view((const char *)string.e, (size_t)string.count) : std::string_view();
+    }
+    
+    class String
+    {
+    public:
+        constexpr String() noexcept : string{}
+        {
+        }
+        
+        explicit String(std::string_view view) : string{}
+        {
+            StringMessage msg = String_From_CountMax((int64_t)view.size());
+            if (IsOk(msg.code))
+            {
+                string = msg.string;
+                std::memcpy(string.e, view.data(), view.size());
+                string.count = (int64_t)view.size();
+            }
+        }
+        
+        explicit String(const char *cStr) : String(std::string_view(cStr ? cStr : ""))
+        {
+        }
+        
+        ~String()
+        {
+            if (string.e)
+            {
+                String_Destroy(&string);
+            }
+        }
+        
+        String(String &&other) noexcept : string(other.string)
+        {
+            other.string = ::String{};
+        }
+        
+        String &operator=(String &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (string.e)
+                {
+                    String_Destroy(&string);
+                }
+                string = other.string;
+                other.string = ::String{};
+            }
+            return *this;
+        }
+        
+        String(const String &other) = delete;
+        String &operator=(const String &other) = delete;
+        
+        // NOTE(s0lly): Takes ownership of a String made by the C functions, e.g. StringMessage::string
+        static String Adopt(::String raw) noexcept
+        {
+            String result;
+            result.string = raw;
+            return result;
+        }
+        
+        // NOTE(s0lly): Hands the String back to the caller, who then has to destroy it
+        ::String Release() noexcept
+        {
+            ::String result = string;
+            string = ::String{};
+            return result;
+        }
+        
+        String Copy() const
+        {
+            String result;
+            if (string.e)
+            {
+                StringMessage msg = String_From_String(const_cast<::String *>(&string));
+                if (IsOk(msg.code))
+                {
+                    result.string = msg.string;
+                }
+            }
+            return result;
+        }
+        
+        SCL_STRING_CODE Share()
+        {
+            return string.e ? String_Share(&string).code : SCL_STRING_CODE__NO_MESSAGE;
+        }
+        
+        SCL_STRING_CODE Append(std::string_view view)
+        {
+            if (!string.e)
+            {
+                *this = String(view);
+                return SCL_STRING_CODE__NO_MESSAGE;
+            }
+            return String_Append_Generic(&string, (uint8_t *)view.data(), (int64_t)view.size()).code;
+        }
+        
+        ::String *Get() noexcept
+        {
+            return &string;
+        }
+        
+        const ::String *Get() const noexcept
+        {
+            return &string;
+        }
+        
+        std::string_view View() const noexcept
+        {
+            return scl::View(string);
+        }
+        
+        operator std::string_view() const noexcept
+        {
+            return scl::View(string);
+        }
+        
+        const char *CStr() const noexcept
+        {
+            return string.e ? (const char *)string.e : "";
+        }
+        
+        const char *data() const noexcept
+        {
+            return (const char *)string.e;
+        }
+        
+        size_t size() const noexcept
+        {
+            return string.e ? (size_t)string.count : 0;
+        }
+        
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+        
+        friend bool operator==(const String &a, std::string_view b) noexcept
+        {
+            return a.View() == b;
+        }
+        
+        friend bool operator!=(const String &a, std::string_view b) noexcept
+        {
+            return a.View() != b;
+        }
+    
+    private:
+        ::String string;
+    };
+    
+    class StringList
+    {
+    public:
+        // NOTE(s0lly): Walks the list as views into its elements
+        class Iterator
+        {
+        public:
+            // NOTE(s0lly): The views are made on the fly, so operator-> returns one held by value in this proxy
+            class ArrowProxy
+            {
+            public:
+                constexpr explicit ArrowProxy(std::string_view view) noexcept : view(view)
+                {
+                }
+                
+                constexpr const std::string_view *operator->() const noexcept
+                {
+                    return &view;
+                }
+            
+            private:
+                std::string_view view;
+            };
+            
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = ArrowProxy;
+            using reference = std::string_view;
+            
+            constexpr Iterator() noexcept : e(nullptr)
+            {
+            }
+            
+            constexpr explicit Iterator(const ::String *e) noexcept : e(e)
+            {
+            }
+            
+            std::string_view operator*() const noexcept
+            {
+                return scl::View(*e);
+            }
+            
+            ArrowProxy operator->() const noexcept
+            {
+                return ArrowProxy(scl::View(*e));
+            }
+            
+            std::string_view operator[](difference_type offset) const noexcept
+            {
+                return scl::View(e[offset]);
+            }
+            
+            Iterator &operator++() noexcept
+            {
+                e++;
+                return *this;
+            }
+            
+            Iterator operator++(int) noexcept
+            {
+                Iterator result = *this;
+                e++;
+                return result;
+            }
+            
+            Iterator &operator--() noexcept
+            {
+                e--;
+                return *this;
+            }
+            
+            Iterator operator--(int) noexcept
+            {
+                Iterator result = *this;
+                e--;
+                return result;
+            }
+            
+            Iterator &operator+=(difference_type offset) noexcept
+            {
+                e += offset;
+                return *this;
+            }
+            
+            Iterator &operator-=(difference_type offset) noexcept
+            {
+                e -= offset;
+                return *this;
+            }
+            
+            friend Iterator operator+(Iterator it, difference_type offset) noexcept
+            {
+                return it += offset;
+            }
+            
+            friend Iterator operator+(difference_type offset, Iterator it) noexcept
+            {
+                return it += offset;
+            }
+            
+            friend Iterator operator-(Iterator it, difference_type offset) noexcept
+            {
+                return it -= offset;
+            }
+            
+            friend difference_type operator-(Iterator a, Iterator b) noexcept
+            {
+                return a.e - b.e;
+            }
+            
+            friend bool operator==(Iterator a, Iterator b) noexcept
+            {
+                return a.e == b.e;
+            }
+            
+            friend bool operator!=(Iterator a, Iterator b) noexcept
+            {
+                return a.e != b.e;
+            }
+            
+            friend bool operator<(Iterator a, Iterator b) noexcept
+            {
+                return a.e < b.e;
+            }
+            
+            friend bool operator>(Iterator a, Iterator b) noexcept
+            {
+                return a.e > b.e;
+            }
+            
+            friend bool operator<=(Iterator a, Iterator b) noexcept
+            {
+                return a.e <= b.e;
+            }
+            
+            friend bool operator>=(Iterator a, Iterator b) noexcept
+            {
+                return a.e >= b.e;
+            }
+        
+        private:
+            const ::String *e;
+        };
+        
+        constexpr StringList() noexcept : stringList{}
+        {
+        }
+        
+        ~StringList()
+        {
+            if (stringList.e)
+            {
+                StringList_Destroy(&stringList);
+            }
+        }
+        
+        StringList(StringList &&other) noexcept : stringList(other.stringList)
+        {
+            other.stringList = ::StringList{};
+        }
+        
+        StringList &operator=(StringList &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (stringList.e)
+                {
+                    StringList_Destroy(&stringList);
+                }
+                stringList = other.stringList;
+                other.stringList = ::StringList{};
+            }
+            return *this;
+        }
+        
+        StringList(const StringList &other) = delete;
+        StringList &operator=(const StringList &other) = delete;
+        
+        static StringList Adopt(::StringList raw) noexcept
+        {
+            StringList result;
+            result.stringList = raw;
+            return result;
+        }
+        
+        ::StringList Release() noexcept
+        {
+            ::StringList result = stringList;
+            stringList = ::StringList{};
+            return result;
+        }
+        
+        static StringList From_Filename(const char *filename)
+        {
+            return Adopt(StringList_From_Filename_CStr(filename));
+        }
+        
+        static StringList From_SplitByDelimiters(const String &string, const String &delimiters, const String &ignoreChs)
+        {
+            return Adopt(StringList_From_String_SplitByDelimiters(const_cast<::String *>(string.Get()), const_cast<::String *>(delimiters.Get()),
+                                                                  const_cast<::String *>(ignoreChs.Get())));
+        }
+        
+        // NOTE(s0lly): Element copies go through String_From_String, so shared elements are copied in O(1)
+        StringList Copy() const
+        {
+            StringList result;
+            if (stringList.e && stringList.count > 0)
+            {
+                result.stringList = StringList_From_CountMax(stringList.count);
+                for (int64_t stringIndex = 0; stringIndex < stringList.count; stringIndex++)
+                {
+                    StringList_PushCopy(&result.stringList, &stringList.e[stringIndex]);
+                }
+            }
+            return result;
+        }
+        
+        void Push(std::string_view view)
+        {
+            Push(String(view));
+        }
+        
+        // NOTE(s0lly): Moves the string's buffer into the list
+        void Push(String &&string)
+        {
+            if (!stringList.e)
+            {
+                stringList = StringList_From_CountMax(16);
+            }
+            else if (stringList.count >= stringList.countMax)
+            {
+                StringList_Resize(&stringList, stringList.countMax * 2);
+            }
+            stringList.e[stringList.count++] = string.Release();
+        }
+        
+        ::StringList *Get() noexcept
+        {
+            return &stringList;
+        }
+        
+        const ::StringList *Get() const noexcept
+        {
+            return &stringList;
+        }
+        
+        std::string_view operator[](size_t index) const noexcept
+        {
+            return scl::View(stringList.e[index]);
+        }
+        
+        size_t size() const noexcept
+        {
+            return stringList.e ? (size_t)stringList.count : 0;
+        }
+        
+        bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+        
+        Iterator begin() const noexcept
+        {
+            return Iterator(stringList.e);
+        }
+        
+        Iterator end() const noexcept
+        {
+            return Iterator(stringList.e + size());
+        }
+    
+    private:
+        ::StringList stringList;
+    };
+}
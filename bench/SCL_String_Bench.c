@@ -0,0 +1,588 @@
+
+/*********************************************************************************************************
+
+File Name           : SCL_String_Bench.c
+Author              : s0lly
+License             : The Unlicense / Public Domain (see SCL_String.h for license description)
+
+Benchmark harness for the hot functions of SCL_String.h.
+
+Build (from the repository root, or via "make" - see the Makefile):
+    msvc        : cl /O2 bench\SCL_String_Bench.c
+    gcc / clang : cc -O2 -std=c11 bench/SCL_String_Bench.c -o SCL_String_Bench -pthread
+
+Usage:
+    SCL_String_Bench [--corpus file] [--baseline file] [--threshold percent] [--min-time seconds] [--samples count]
+
+Results are written to stdout as JSON with one benchmark per line, reporting ns/op, GB/s and allocations/op.
+Each benchmark is sampled --samples times (default 5) for at least --min-time seconds each (default 0.2), and its
+fastest sample is reported. Save the output of a run to a file and pass it back via --baseline to compare against
+it: any benchmark that is slower than the baseline by more than the threshold (default 25%) is reported on stderr
+and the harness exits with a non-zero code.
+
+Without --corpus a deterministic corpus of log- and CSV-style lines is generated.
+
+*********************************************************************************************************/
+
+#define _CRT_SECURE_NO_WARNINGS
+// NOTE(s0lly): -std=c11 hides clock_gettime unless a feature macro is set
+#if !defined(_WIN32) && defined(__STRICT_ANSI__) && !defined(_POSIX_C_SOURCE) && !defined(_XOPEN_SOURCE) && !defined(_GNU_SOURCE) && !defined(_DEFAULT_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+// NOTE(s0lly): All library allocations go through the single calloc in Mem_Alloc, so counting them here is exact
+static int64_t benchAllocCount = 0;
+
+// NOTE(s0lly): Results are written here so the compiler can't discard the benchmarked calls
+static volatile int64_t benchSink = 0;
+
+static void *Bench_Calloc(size_t count, size_t elementSize)
+{
+    benchAllocCount++;
+    return calloc(count, elementSize);
+}
+
+#define calloc Bench_Calloc
+#include "../SCL_String.h"
+#undef calloc
+
+
+// NOTE(s0lly): Structs
+
+typedef struct BenchCorpus
+{
+    String text;
+    StringList lines;
+    String filename;
+
+    // NOTE(s0lly): Inputs made once up front, so that their allocations are not timed or counted as part of any op
+    String textHead64k;
+    String textHead256k;
+    String scratch;
+    String needleAbsent;
+    String needleError;
+    String replacement;
+    String delimiters;
+    String ignoreChs;
+    String int64Text;
+    String doubleText;
+    StringPattern pattern;
+
+} BenchCorpus;
+
+typedef struct BenchResult
+{
+    const char *name;
+    int64_t ops;
+    int64_t bytes;
+    int64_t allocs;
+    double seconds;
+
+} BenchResult;
+
+// NOTE(s0lly): Each benchmark runs one batch and reports how many operations and bytes that batch covered
+typedef void (*BenchFunction)(BenchCorpus *corpus, int64_t *ops, int64_t *bytes);
+
+typedef struct BenchEntry
+{
+    const char *name;
+    BenchFunction function;
+
+} BenchEntry;
+
+
+// NOTE(s0lly): Helper functions
+
+// NOTE(s0lly): A monotonic clock, so that a step of the wall clock can't fake or hide a regression
+static double Bench_Seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+static int64_t Bench_Min(int64_t a, int64_t b)
+{
+    return a < b ? a : b;
+}
+
+static int64_t Bench_Max(int64_t a, int64_t b)
+{
+    return a > b ? a : b;
+}
+
+static uint64_t Bench_Random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static BenchCorpus BenchCorpus_Generate(int64_t lineCount)
+{
+    static const char *words[] = { "alpha", "beta", "gamma", "delta", "request", "timeout", "ERROR", "INFO",
+                                   "WARN", "user", "session", "cache", "miss", "hit", "latency", "ms" };
+
+    BenchCorpus corpus = { 0 };
+    corpus.text = String_From_CountMax(lineCount * 96).string;
+
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    uint8_t line[256];
+    for (int64_t lineIndex = 0; lineIndex < lineCount; lineIndex++)
+    {
+        int32_t lineLength = 0;
+        if (lineIndex % 4 == 0)
+        {
+            lineLength = sprintf((char *)line, "%lld,%d.%03d,%s,%s,\"%s, %s\",%d",
+                                (long long)lineIndex, (int32_t)(Bench_Random(&state) % 100000),
+                                (int32_t)(Bench_Random(&state) % 1000),
+                                words[Bench_Random(&state) % 16], words[Bench_Random(&state) % 16],
+                                words[Bench_Random(&state) % 16], words[Bench_Random(&state) % 16],
+                                (int32_t)(Bench_Random(&state) % 500));
+        }
+        else
+        {
+            lineLength = sprintf((char *)line, "  2021-12-30 12:%02d:%02d %s %s %s %s %s  ",
+                                (int32_t)(Bench_Random(&state) % 60), (int32_t)(Bench_Random(&state) % 60),
+                                words[Bench_Random(&state) % 16], words[Bench_Random(&state) % 16],
+                                words[Bench_Random(&state) % 16], words[Bench_Random(&state) % 16],
+                                words[Bench_Random(&state) % 16]);
+        }
+        String_Append_Generic(&corpus.text, line, lineLength);
+        String_Append_uint8_t(&corpus.text, '\n');
+    }
+
+    return corpus;
+}
+
+static BenchCorpus BenchCorpus_From_Filename(const char *filename)
+{
+    BenchCorpus corpus = { 0 };
+    FILE *handle = fopen(filename, "rb");
+    if (handle)
+    {
+        fseek(handle, 0, SEEK_END);
+        int64_t byteCount = (int64_t)ftell(handle);
+        fseek(handle, 0, SEEK_SET);
+        corpus.text = String_From_CountMax(byteCount).string;
+        corpus.text.count = (int64_t)fread(corpus.text.e, 1, byteCount, handle);
+        fclose(handle);
+    }
+    return corpus;
+}
+
+static void BenchCorpus_Finalise(BenchCorpus *corpus, const char *filename)
+{
+    if (filename)
+    {
+        corpus->filename = String_From_CStr(filename).string;
+    }
+    else
+    {
+        corpus->filename = String_From_CStr("SCL_String_Bench_corpus.txt").string;
+        FILE *handle = fopen((const char *)corpus->filename.e, "wb");
+        if (handle)
+        {
+            fwrite(corpus->text.e, 1, corpus->text.count, handle);
+            fclose(handle);
+        }
+    }
+
+    StringListFlat flatLines = StringListFlat_From_Filename_String(&corpus->filename);
+    corpus->lines = StringList_From_StringListFlat(&flatLines);
+    StringListFlat_Destroy(&flatLines);
+
+    corpus->textHead64k = String_From_SubString(&corpus->text, 0, Bench_Min(corpus->text.count, 64 * 1024) - 1).string;
+    corpus->textHead256k = String_From_SubString(&corpus->text, 0, Bench_Min(corpus->text.count, 256 * 1024) - 1).string;
+    corpus->scratch = String_From_CountMax(2 * 64 * 1024).string;
+    corpus->needleAbsent = String_From_CStr("needle-not-present").string;
+    corpus->needleError = String_From_CStr("ERROR").string;
+    corpus->replacement = String_From_CStr("FAILURE").string;
+    corpus->delimiters = String_From_CStr(", ").string;
+    corpus->ignoreChs = String_From_CStr("\"").string;
+    corpus->int64Text = String_From_CStr("-1234567890123").string;
+    corpus->doubleText = String_From_CStr("-12345.678901").string;
+    corpus->pattern = StringPattern_From_CStr("*ERROR*timeout*", SCL_STRING_PATTERN_TYPE__GLOB);
+}
+
+static void BenchCorpus_Destroy(BenchCorpus *corpus, int32_t removeFile)
+{
+    if (removeFile)
+    {
+        remove((const char *)corpus->filename.e);
+    }
+    String_Destroy(&corpus->text);
+    String_Destroy(&corpus->filename);
+    StringList_Destroy(&corpus->lines);
+    String_Destroy(&corpus->textHead64k);
+    String_Destroy(&corpus->textHead256k);
+    String_Destroy(&corpus->scratch);
+    String_Destroy(&corpus->needleAbsent);
+    String_Destroy(&corpus->needleError);
+    String_Destroy(&corpus->replacement);
+    String_Destroy(&corpus->delimiters);
+    String_Destroy(&corpus->ignoreChs);
+    String_Destroy(&corpus->int64Text);
+    String_Destroy(&corpus->doubleText);
+    StringPattern_Destroy(&corpus->pattern);
+}
+
+
+// NOTE(s0lly): Benchmarks
+
+static void Bench_Append(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    (void)corpus;
+    String string = String_From_CStr("").string;
+    for (int32_t i = 0; i < 10000; i++)
+    {
+        String_Append_CStr(&string, (uint8_t *)"token,");
+    }
+    *ops = 10000;
+    *bytes = string.count;
+    String_Destroy(&string);
+}
+
+static void Bench_Insert(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    (void)corpus;
+    String string = String_From_CStr("0123456789abcdef0123456789abcdef").string;
+    for (int32_t i = 0; i < 2000; i++)
+    {
+        String_Insert_CStr(&string, (uint8_t *)"-insert-", string.count / 2);
+    }
+    *ops = 2000;
+    *bytes = string.count;
+    String_Destroy(&string);
+}
+
+static void Bench_Find_First(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    benchSink += String_Find_FirstFrom(&corpus->text, &corpus->needleAbsent, 0).code;
+    *ops = 1;
+    *bytes = corpus->text.count;
+}
+
+static void Bench_Find_Last(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    benchSink += String_Find_LastFrom(&corpus->textHead256k, &corpus->needleError, 0).int64Val;
+    *ops = 1;
+    *bytes = corpus->textHead256k.count;
+}
+
+static void Bench_Pattern_Match(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    *bytes = 0;
+    for (int64_t lineIndex = 0; lineIndex < corpus->lines.count; lineIndex++)
+    {
+        String *line = StringList_Get(&corpus->lines, lineIndex);
+        benchSink += StringPattern_Match(&corpus->pattern, line).code;
+        *bytes += line->count;
+    }
+    *ops = corpus->lines.count;
+}
+
+static void Bench_Replace_All(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    // NOTE(s0lly): The scratch buffer has room for the grown result, so only the replace itself can allocate
+    String *string = &corpus->scratch;
+    memcpy(string->e, corpus->textHead64k.e, corpus->textHead64k.count);
+    string->e[corpus->textHead64k.count] = '\0';
+    string->count = corpus->textHead64k.count;
+    String_FindReplaceFrom_All(string, &corpus->needleError, &corpus->replacement, 0);
+    *ops = 1;
+    *bytes = corpus->textHead64k.count;
+}
+
+static void Bench_Split(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    int64_t lineCount = Bench_Min(corpus->lines.count, 1000);
+    *bytes = 0;
+    for (int64_t lineIndex = 0; lineIndex < lineCount; lineIndex++)
+    {
+        String *line = StringList_Get(&corpus->lines, lineIndex);
+        StringList split = StringList_From_String_SplitByDelimiters(line, &corpus->delimiters, &corpus->ignoreChs);
+        *bytes += line->count;
+        StringList_Destroy(&split);
+    }
+    *ops = lineCount;
+}
+
+static void Bench_File_Lines(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    StringList lines = StringList_From_Filename_String(&corpus->filename);
+    *ops = lines.count;
+    *bytes = corpus->text.count;
+    StringList_Destroy(&lines);
+}
+
+static void Bench_File_Lines_Flat(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    StringListFlat lines = StringListFlat_From_Filename_String(&corpus->filename);
+    *ops = lines.count;
+    *bytes = corpus->text.count;
+    StringListFlat_Destroy(&lines);
+}
+
+static void Bench_int64_t_Parse(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    for (int32_t i = 0; i < 1000; i++)
+    {
+        benchSink += int64_t_From_String(&corpus->int64Text).int64Val;
+    }
+    *ops = 1000;
+    *bytes = 1000 * corpus->int64Text.count;
+}
+
+static void Bench_int64_t_Format(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    (void)corpus;
+    *bytes = 0;
+    for (int64_t i = 0; i < 1000; i++)
+    {
+        String string = String_From_int64_t(i * 7919 - 3000000).string;
+        *bytes += string.count;
+        String_Destroy(&string);
+    }
+    *ops = 1000;
+}
+
+static void Bench_double_Parse(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    for (int32_t i = 0; i < 1000; i++)
+    {
+        benchSink += (int64_t)double_From_String(&corpus->doubleText).doubleVal;
+    }
+    *ops = 1000;
+    *bytes = 1000 * corpus->doubleText.count;
+}
+
+static void Bench_double_Format(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    (void)corpus;
+    *bytes = 0;
+    for (int64_t i = 0; i < 1000; i++)
+    {
+        String string = String_From_double((double)i * 3.14159 - 1000.0).string;
+        *bytes += string.count;
+        String_Destroy(&string);
+    }
+    *ops = 1000;
+}
+
+static void Bench_Case(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    String_ToUpper(&corpus->text);
+    String_ToLower(&corpus->text);
+    *ops = 2;
+    *bytes = 2 * corpus->text.count;
+}
+
+static void Bench_Trim(BenchCorpus *corpus, int64_t *ops, int64_t *bytes)
+{
+    String *scratch = &corpus->scratch;
+    int64_t lineCount = Bench_Min(corpus->lines.count, 10000);
+    *bytes = 0;
+    for (int64_t lineIndex = 0; lineIndex < lineCount; lineIndex++)
+    {
+        String *line = StringList_Get(&corpus->lines, lineIndex);
+        int64_t lineLength = Bench_Min(line->count, scratch->countMax);
+        memcpy(scratch->e, line->e, lineLength);
+        scratch->e[lineLength] = '\0';
+        scratch->count = lineLength;
+        String_Remove_WhitespaceSurrounding(scratch);
+        *bytes += lineLength;
+    }
+    *ops = lineCount;
+}
+
+
+// NOTE(s0lly): Runner
+
+static BenchResult Bench_Run(const char *name, BenchFunction function, BenchCorpus *corpus, double minSeconds)
+{
+    BenchResult result = { 0 };
+    result.name = name;
+
+    int64_t allocCountStart = benchAllocCount;
+    double timeStart = Bench_Seconds();
+    while (result.seconds < minSeconds)
+    {
+        int64_t ops = 0;
+        int64_t bytes = 0;
+        function(corpus, &ops, &bytes);
+        result.ops += ops;
+        result.bytes += bytes;
+        result.seconds = Bench_Seconds() - timeStart;
+    }
+    result.allocs = benchAllocCount - allocCountStart;
+
+    return result;
+}
+
+static double Bench_Baseline_Find(String *baseline, const char *name)
+{
+    double result = -1.0;
+    if (baseline->e)
+    {
+        uint8_t key[128];
+        sprintf((char *)key, "\"name\": \"%s\"", name);
+        uint8_t *found = (uint8_t *)strstr((const char *)baseline->e, (const char *)key);
+        if (found)
+        {
+            uint8_t *value = (uint8_t *)strstr((const char *)found, "\"ns_per_op\": ");
+            if (value)
+            {
+                result = atof((const char *)value + strlen("\"ns_per_op\": "));
+            }
+        }
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const char *corpusFilename = 0;
+    const char *baselineFilename = 0;
+    double thresholdPercent = 25.0;
+    double minSeconds = 0.2;
+    int32_t sampleCount = 5;
+
+    for (int32_t argIndex = 1; argIndex + 1 < argc; argIndex += 2)
+    {
+        if (strcmp(argv[argIndex], "--corpus") == 0)
+        {
+            corpusFilename = argv[argIndex + 1];
+        }
+        else if (strcmp(argv[argIndex], "--baseline") == 0)
+        {
+            baselineFilename = argv[argIndex + 1];
+        }
+        else if (strcmp(argv[argIndex], "--threshold") == 0)
+        {
+            thresholdPercent = atof(argv[argIndex + 1]);
+        }
+        else if (strcmp(argv[argIndex], "--min-time") == 0)
+        {
+            minSeconds = atof(argv[argIndex + 1]);
+        }
+        else if (strcmp(argv[argIndex], "--samples") == 0)
+        {
+            sampleCount = (int32_t)Bench_Max(1, atoi(argv[argIndex + 1]));
+        }
+    }
+
+    BenchCorpus corpus = corpusFilename ? BenchCorpus_From_Filename(corpusFilename) : BenchCorpus_Generate(20000);
+    if (!corpus.text.e || corpus.text.count == 0)
+    {
+        fprintf(stderr, "Could not load corpus\n");
+        return 2;
+    }
+    BenchCorpus_Finalise(&corpus, corpusFilename);
+
+    BenchCorpus baselineCorpus = { 0 };
+    if (baselineFilename)
+    {
+        baselineCorpus = BenchCorpus_From_Filename(baselineFilename);
+        if (!baselineCorpus.text.e)
+        {
+            fprintf(stderr, "Could not load baseline %s\n", baselineFilename);
+        }
+    }
+
+    BenchEntry entries[] =
+    {
+        { "append", Bench_Append },
+        { "insert", Bench_Insert },
+        { "find_first", Bench_Find_First },
+        { "find_last", Bench_Find_Last },
+        { "pattern_match", Bench_Pattern_Match },
+        { "replace_all", Bench_Replace_All },
+        { "split", Bench_Split },
+        { "file_lines", Bench_File_Lines },
+        { "file_lines_flat", Bench_File_Lines_Flat },
+        { "int64_t_parse", Bench_int64_t_Parse },
+        { "int64_t_format", Bench_int64_t_Format },
+        { "double_parse", Bench_double_Parse },
+        { "double_format", Bench_double_Format },
+        { "case_convert", Bench_Case },
+        { "trim", Bench_Trim },
+    };
+    int32_t entryCount = (int32_t)(sizeof(entries) / sizeof(entries[0]));
+    int32_t regressionCount = 0;
+
+    // NOTE(s0lly): Each benchmark keeps its fastest sample - interference from the rest of the machine only ever adds
+    // time, so the minimum is far more stable between runs than a single sample. Samples are taken in rounds over all
+    // benchmarks, so that a slow spell on the machine can't cover every sample of one benchmark.
+    BenchResult results[sizeof(entries) / sizeof(entries[0])] = { 0 };
+    for (int32_t sampleIndex = 0; sampleIndex < sampleCount; sampleIndex++)
+    {
+        for (int32_t entryIndex = 0; entryIndex < entryCount; entryIndex++)
+        {
+            BenchResult sample = Bench_Run(entries[entryIndex].name, entries[entryIndex].function, &corpus, minSeconds);
+            BenchResult *best = &results[entryIndex];
+            if (sampleIndex == 0 || sample.seconds * (double)best->ops < best->seconds * (double)sample.ops)
+            {
+                *best = sample;
+            }
+        }
+    }
+
+    printf("{\n");
+    printf("  \"corpus\": \"%s\",\n", corpusFilename ? corpusFilename : "generated");
+    printf("  \"corpus_bytes\": %lld,\n", (long long)corpus.text.count);
+    printf("  \"benchmarks\": [\n");
+
+    for (int32_t entryIndex = 0; entryIndex < entryCount; entryIndex++)
+    {
+        BenchResult result = results[entryIndex];
+        double nsPerOp = result.seconds * 1e9 / (double)Bench_Max(result.ops, 1);
+        double gbPerSecond = (double)result.bytes / result.seconds * 1e-9;
+        double allocsPerOp = (double)result.allocs / (double)Bench_Max(result.ops, 1);
+
+        printf("    { \"name\": \"%s\", \"ns_per_op\": %.3f, \"gb_per_s\": %.4f, \"allocs_per_op\": %.3f, \"ops\": %lld }%s\n",
+               result.name, nsPerOp, gbPerSecond, allocsPerOp, (long long)result.ops,
+               entryIndex + 1 < entryCount ? "," : "");
+
+        double baselineNsPerOp = Bench_Baseline_Find(&baselineCorpus.text, result.name);
+        if (baselineNsPerOp > 0.0)
+        {
+            double changePercent = (nsPerOp - baselineNsPerOp) / baselineNsPerOp * 100.0;
+            if (changePercent > thresholdPercent)
+            {
+                fprintf(stderr, "REGRESSION %-16s %12.3f ns/op vs baseline %12.3f (%+.1f%%)\n",
+                        result.name, nsPerOp, baselineNsPerOp, changePercent);
+                regressionCount++;
+            }
+            else
+            {
+                fprintf(stderr, "ok         %-16s %12.3f ns/op vs baseline %12.3f (%+.1f%%)\n",
+                        result.name, nsPerOp, baselineNsPerOp, changePercent);
+            }
+        }
+    }
+
+    printf("  ]\n");
+    printf("}\n");
+
+    String_Destroy(&baselineCorpus.text);
+    BenchCorpus_Destroy(&corpus, corpusFilename == 0);
+
+    return regressionCount > 0 ? 1 : 0;
+}